@@ -19,6 +19,7 @@ int main(int argc, char *argv[])
     bool pairFilePresent = false;
     bool compressionParamPresent = false;
     bool decompressMode = false;
+    double maxMemoryInGB = 0;
 
 #ifndef DEVELOPER_BUILD
     NullBuffer null_buffer;
@@ -27,10 +28,10 @@ int main(int argc, char *argv[])
 #endif
 
 #ifdef DEVELOPER_BUILD
-    while ((opt = getopt(argc, argv, "c:t:i:q:g:s:M:p:l:B:E:doSIrNVvTaA?")) != -1) {
+    while ((opt = getopt(argc, argv, "c:t:m:i:q:g:s:M:p:l:B:E:doSIrNVvTaA?")) != -1) {
         char* valPtr;
 #else
-    while ((opt = getopt(argc, argv, "c:t:i:q:g:s:M:p:do?")) != -1) {
+    while ((opt = getopt(argc, argv, "c:t:m:i:q:g:s:M:p:do?")) != -1) {
 #endif
         switch (opt) {
             case 'c':
@@ -40,7 +41,8 @@ int main(int argc, char *argv[])
             case 'i':
                 pgRC->setSrcFastqFile(optarg);
                 srcFilePresent = true;
-                if (optind < (argc - 1) && argv[optind][0] != '-') {
+                if (optind < (argc - 1) && (argv[optind][0] != '-' ||
+                        (argv[optind][1] == 0 && string(optarg) != "-"))) {
                     pgRC->setPairFastqFile(argv[optind++]);
                     pairFilePresent = true;
                 }
@@ -55,6 +57,9 @@ int main(int argc, char *argv[])
             case 't':
                 numberOfThreads = atoi(optarg);
                 break;
+            case 'm':
+                maxMemoryInGB = atof(optarg);
+                break;
 
             case 'q':
                 compressionParamPresent = true;
@@ -158,10 +163,13 @@ int main(int argc, char *argv[])
                 fprintf(stderr, "PgRC %d.%d: Copyright (c) 2020 Tomasz Kowalski, Szymon Grabowski: %s\n\n",
                         (int) PGRC_VERSION_MAJOR, (int) PGRC_VERSION_MINOR, RELEASE_DATE);
                 fprintf(stderr, "Usage: %s [-c compressionLevel] [-i seqSrcFile [pairSrcFile]] [-t noOfThreads]"
-                                "\n[-o] [-d] archiveName\n\n", argv[0]);
+                                "\n[-m maxMemoryInGB] [-o] [-d] archiveName\n\n", argv[0]);
                 fprintf(stderr, "-c compression levels: 1 - fast; 2 - default; 3 - max\n");
                 fprintf(stderr, "-t number of threads used (8 - default)\n");
+                fprintf(stderr, "-m memory limit of pseudogenome generation in GB; exceeding reads indexes are\n"
+                                "   spilled to temporary files next to the archive (0 - unlimited, default)\n");
                 fprintf(stderr, "-d decompression mode\n");
+                fprintf(stderr, "-i source files can be named pipes or '-' (standard input)\n");
                 fprintf(stderr, "-o preserve original read order information\n\n");
                 fprintf(stderr, "------------------ EXPERT OPTIONS ----------------\n");
                 fprintf(stderr, "[-q qualityStreamErrorProbability*1000] (1000=>disable)\n"
@@ -220,6 +228,11 @@ int main(int argc, char *argv[])
         fprintf(stderr, "The number of threads must be positive.\n");
         exit(EXIT_FAILURE);
     }
+    if (maxMemoryInGB < 0) {
+        fprintf(stderr, "The memory limit cannot be negative.\n");
+        exit(EXIT_FAILURE);
+    }
+    maxMemoryUsage = maxMemoryInGB * (1 << 30);
     omp_set_num_threads(numberOfThreads);
 
     pgRC->setPgRCFileName(argv[optind++]);
@@ -20,8 +20,6 @@ namespace PgTools {
     static const char *const TEMPORARY_FILE_SUFFIX = ".temp";
     static const char *const PGRC_HEADER = "PgRC";
 
-    uint_read_len_max probeReadsLength(const string &srcFastqFile);
-
     time_t getTimeInSec(chrono::steady_clock::time_point end_t, chrono::steady_clock::time_point begin_t) {
         chrono::nanoseconds time_span = chrono::duration_cast<chrono::nanoseconds>(end_t - begin_t);
         return (double)time_span.count() / 1000000.0;
@@ -71,13 +69,13 @@ namespace PgTools {
         initCompressionParameters();
         qualityDivision = error_limit_in_promils < 1000;
         generatorDivision = gen_quality_coef > 0;
-        readLength = probeReadsLength(srcFastqFile);
         if (pairFastqFile.empty() && !preserveOrderMode)
             singleReadsMode = true;
 
         if (std::ifstream(pgRCFileName))
             fprintf(stderr, "Warning: file %s already exists\n", pgRCFileName.data());
         pgrcOut = fstream(pgRCFileName + TEMPORARY_FILE_SUFFIX, ios::out | ios::binary | ios::trunc);
+        tempFilesPrefix = pgRCFileName + TEMPORARY_FILE_SUFFIX + "_";
         pgrcOut.write(PGRC_HEADER, strlen(PGRC_HEADER));
         pgrcOut.put(PGRC_VERSION_MODE);
         pgrcOut.put(PGRC_VERSION_MAJOR);
@@ -143,6 +141,9 @@ namespace PgTools {
         start_t = chrono::steady_clock::now();
         prepareChainData();
         stageCount = 0;
+        // stages up to LQ Pg generation consume the source reads
+        if (skipStages < 5)
+            loadAllReads();
         if (skipStages < ++stageCount && qualityDivision) {
             runQualityBasedDivision();
             if (disableInMemoryMode || endAtStage == stageCount) {
@@ -206,12 +207,12 @@ namespace PgTools {
                 if (preserveOrderMode) {
                     ExtendedReadsListWithConstantAccessOption *const pgRl = lqPg->getReadsList();
                     uint_pg_len_max pos = hqPg->getPseudoGenomeLength();
-                    for (uint_reads_cnt_std i = 0; i < pgRl->readsCount; i++) {
+                    for (uint_reads_cnt_max i = 0; i < pgRl->readsCount; i++) {
                         pos += pgRl->off[i];
                         orgIdx2PgPos[pgRl->orgIdx[i]] = pos;
                     }
                 } else
-                    rlIdxOrder.insert(rlIdxOrder.end(), lqPg->getReadsList()->orgIdx.begin(), lqPg->getReadsList()->orgIdx.end());
+                    rlIdxOrder.append(lqPg->getReadsList()->orgIdx);
             }
             lqPg->disposeReadsList();
             if (separateNReads) {
@@ -225,13 +226,12 @@ namespace PgTools {
                     if (preserveOrderMode) {
                         ExtendedReadsListWithConstantAccessOption *const pgRl = nPg->getReadsList();
                         uint_pg_len_max pos = hqPg->getPseudoGenomeLength() + lqPg->getPseudoGenomeLength();
-                        for (uint_reads_cnt_std i = 0; i < pgRl->readsCount; i++) {
+                        for (uint_reads_cnt_max i = 0; i < pgRl->readsCount; i++) {
                             pos += pgRl->off[i];
                             orgIdx2PgPos[pgRl->orgIdx[i]] = pos;
                         }
                     } else
-                        rlIdxOrder.insert(rlIdxOrder.end(), nPg->getReadsList()->orgIdx.begin(),
-                                   nPg->getReadsList()->orgIdx.end());
+                        rlIdxOrder.append(nPg->getReadsList()->orgIdx);
                 }
                 nPg->disposeReadsList();
             }
@@ -252,6 +252,7 @@ namespace PgTools {
                             joinedPgLength, compressionLevel, pairFastqFile.empty());
                 orgIdx2PgPos.clear();
             } else {
+                rlIdxOrder.fitReadsCount(rlIdxOrder.size());
                 SeparatedPseudoGenomePersistence::compressReadsOrder(pgrcOut, rlIdxOrder, compressionLevel, preserveOrderMode,
                                                                      ignorePairOrderInformation, pairFastqFile.empty());
                 rlIdxOrder.clear();
@@ -275,18 +276,44 @@ namespace PgTools {
         }
         finalizeCompression();
         disposeChainData();
+        disposeAllReads();
 #ifdef DEVELOPER_BUILD
         generateReport();
 #endif
     }
 
+    void PgRCManager::loadAllReads() {
+        allReadsSet = DividedPCLReadsSets::loadReadsSetWithQualityClasses(srcFastqFile, pairFastqFile, revComplPairFile,
+                qualityDivision ? error_limit_in_promils / 1000.0 : 1, readsQualityClass);
+        readLength = allReadsSet->maxReadLength();
+    }
+
+    ReadsSourceIteratorTemplate<uint_read_len_max> *PgRCManager::createAllReadsIterator() {
+        if (!allReadsSet)
+            loadAllReads();
+        return new PackedConstantLengthReadsSetIterator<uint_read_len_max>(allReadsSet);
+    }
+
+    void PgRCManager::disposeAllReads() {
+        if (allReadsSet) {
+            delete (allReadsSet);
+            allReadsSet = 0;
+        }
+        readsQualityClass.clear();
+        readsQualityClass.shrink_to_fit();
+    }
+
+    void PgRCManager::releaseAllReads() {
+        // in disabled in-memory mode a reopenable source is parsed again by the next stage
+        if (!disableInMemoryMode || (!ReadsSetPersistence::isStreamSource(srcFastqFile) &&
+                !ReadsSetPersistence::isStreamSource(pairFastqFile)))
+            disposeAllReads();
+    }
+
     void PgRCManager::runQualityBasedDivision() {
-        ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = ReadsSetPersistence::createManagedReadsIterator(
-                srcFastqFile, pairFastqFile, revComplPairFile);
-        divReadsSets =
-                DividedPCLReadsSets::getQualityDivisionBasedReadsSets(allReadsIterator, readLength, error_limit_in_promils / 1000.0,
-                        separateNReads, nReadsLQ);
-        delete (allReadsIterator);
+        divReadsSets = DividedPCLReadsSets::getQualityClassBasedReadsSets(allReadsSet, readsQualityClass,
+                separateNReads, nReadsLQ);
+        releaseAllReads();
     }
 
     void PgRCManager::persistReadsQualityDivision() {
@@ -297,16 +324,16 @@ namespace PgTools {
 
     void PgRCManager::prepareForPgGeneratorBaseReadsDivision() {
         if (!divReadsSets) {
-            ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = ReadsSetPersistence::createManagedReadsIterator(
-                    srcFastqFile, pairFastqFile, revComplPairFile);
             if (qualityDivision) {
+                ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = createAllReadsIterator();
                 divReadsSets = DividedPCLReadsSets::loadDivisionReadsSets(
                         allReadsIterator, readLength, lqDivisionFile, nReadsLQ, separateNReads ? nDivisionFile : "");
+                delete (allReadsIterator);
             } else {
-                divReadsSets = DividedPCLReadsSets::getSimpleDividedPCLReadsSets(allReadsIterator, readLength,
-                                                                                     separateNReads, nReadsLQ);
+                divReadsSets = DividedPCLReadsSets::getQualityClassBasedReadsSets(allReadsSet, readsQualityClass,
+                                                                                  separateNReads, nReadsLQ);
             }
-            delete (allReadsIterator);
+            releaseAllReads();
         }
     }
 
@@ -324,11 +351,11 @@ namespace PgTools {
 
     void PgRCManager::prepareForHqPgGeneration() {
         if (!divReadsSets) {
-            ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = ReadsSetPersistence::createManagedReadsIterator(
-                    srcFastqFile, pairFastqFile, revComplPairFile);
+            ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = createAllReadsIterator();
             divReadsSets = DividedPCLReadsSets::loadDivisionReadsSets(
                     allReadsIterator, readLength, lqDivisionFile, nReadsLQ, separateNReads ? nDivisionFile : "");
             delete (allReadsIterator);
+            releaseAllReads();
         }
     }
 
@@ -353,11 +380,11 @@ namespace PgTools {
 
     void PgRCManager::prepareForMappingLQReadsOnHQPg() {
         if (!divReadsSets) {
-            ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = ReadsSetPersistence::createManagedReadsIterator(
-                    srcFastqFile, pairFastqFile, revComplPairFile);
+            ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = createAllReadsIterator();
             divReadsSets = DividedPCLReadsSets::loadDivisionReadsSets(
                     allReadsIterator, readLength, lqDivisionFile, nReadsLQ, separateNReads ? nDivisionFile : "", true);
             delete (allReadsIterator);
+            releaseAllReads();
         }
         if (!hqPg)
             hqPg = SeparatedPseudoGenomePersistence::loadSeparatedPseudoGenome(pgHqPrefix);
@@ -410,12 +437,12 @@ namespace PgTools {
 
     void PgRCManager::prepareForLQPgAndNPgGeneration() {
         if (!divReadsSets) {
-            ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = ReadsSetPersistence::createManagedReadsIterator(
-                    srcFastqFile, pairFastqFile, revComplPairFile);
+            ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = createAllReadsIterator();
             divReadsSets = DividedPCLReadsSets::loadDivisionReadsSets(
                     allReadsIterator, readLength, mappedLqDivisionFile, nReadsLQ, separateNReads ? nDivisionFile : "", true);
             delete (allReadsIterator);
         }
+        disposeAllReads();
     }
 
     void PgRCManager::runLQPgGeneration() {
@@ -759,7 +786,7 @@ namespace PgTools {
                     fout << res;
                     res.resize(0);
                 }
-                uint_reads_cnt_std idx = rlIdxOrder[i];
+                uint_reads_cnt_max idx = rlIdxOrder[i];
                 if (idx < hqReadsCount)
                     hqPg->getRead(idx, readPtr);
                 else {
@@ -792,7 +819,7 @@ namespace PgTools {
             uint64_t totalSize = dnaStreamSize();
             res.reserve(totalSize < res_size_guard ? totalSize : res_size_guard + (readLength + 1));
             uint_reads_cnt_max i = 0;
-            uint_reads_cnt_std endI = (readsTotalCount / parts) * (p + 1);
+            uint_reads_cnt_max endI = (readsTotalCount / parts) * (p + 1);
             for (i = (readsTotalCount / parts) * p; i < endI; i++) {
                 if (res.size() > res_size_guard) {
                     fout << res;
@@ -829,9 +856,9 @@ namespace PgTools {
             lqPg->getReadsList()->orgIdx.clear();
             nPg->getReadsList()->orgIdx.clear();
             uint8_t parts = singleReadsMode?1:2;
-            for (uint_reads_cnt_std i = 0; i < readsTotalCount; i++) {
+            for (uint_reads_cnt_max i = 0; i < readsTotalCount; i++) {
                 uint_pg_len_max pos = isJoinedPgLengthStd ? orgIdx2StdPgPos[i] : orgIdx2PgPos[i];
-                uint_reads_cnt_std orgIdx = i < readsTotalCount / parts ? i * parts : (i - readsTotalCount / parts) * parts + 1;
+                uint_reads_cnt_max orgIdx = i < readsTotalCount / parts ? i * parts : (i - readsTotalCount / parts) * parts + 1;
                 if (pos < hqPgLen)
                     hqPg->getReadsList()->pos.push_back(pos);
                 else if (pos < nonNPgLen) {
@@ -851,9 +878,10 @@ namespace PgTools {
     }
 
     void PgRCManager::validateAllPgs() {
-        vector<uint_reads_cnt_max> orgIdx2rlIdx = getAllPgsOrgIdxs2RlIdx();
-        ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = ReadsSetPersistence::createManagedReadsIterator(
-                srcFastqFile, pairFastqFile);
+        const ReadsIndexesVector orgIdx2rlIdx = getAllPgsOrgIdxs2RlIdx();
+        allReadsSet = DividedPCLReadsSets::loadReadsSetWithQualityClasses(srcFastqFile, pairFastqFile, false, 1,
+                readsQualityClass);
+        ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator = createAllReadsIterator();
 
         vector<bool> validated(readsTotalCount, false);
         uint_reads_cnt_max notValidatedCount = 0;
@@ -897,18 +925,18 @@ namespace PgTools {
             cout << "Validation successful!" << endl;
 
         delete (allReadsIterator);
-
+        disposeAllReads();
     }
 
-    const vector<uint_reads_cnt_max> PgRCManager::getAllPgsOrgIdxs2RlIdx() const {
-        vector<uint_reads_cnt_max> orgIdx2rlIdx;
+    const ReadsIndexesVector PgRCManager::getAllPgsOrgIdxs2RlIdx() const {
+        ReadsIndexesVector orgIdx2rlIdx(readsTotalCount);
         orgIdx2rlIdx.resize(readsTotalCount);
         for(uint_reads_cnt_max i = 0; i < hqPg->getReadsSetProperties()->readsCount; i++)
-            orgIdx2rlIdx[hqPg->getReadsList()->orgIdx[i]] = i;
+            orgIdx2rlIdx.set(hqPg->getReadsList()->orgIdx[i], i);
         for(uint_reads_cnt_max i = 0; i < lqPg->getReadsSetProperties()->readsCount; i++)
-            orgIdx2rlIdx[lqPg->getReadsList()->orgIdx[i]] = hqPg->getReadsSetProperties()->readsCount + i;
+            orgIdx2rlIdx.set(lqPg->getReadsList()->orgIdx[i], hqPg->getReadsSetProperties()->readsCount + i);
         for(uint_reads_cnt_max i = 0; i < nPgReadsCount; i++)
-            orgIdx2rlIdx[nPg->getReadsList()->orgIdx[i]] = nonNPgReadsCount + i;
+            orgIdx2rlIdx.set(nPg->getReadsList()->orgIdx[i], nonNPgReadsCount + i);
         return orgIdx2rlIdx;
     }
 
@@ -929,9 +957,9 @@ namespace PgTools {
         uint_reads_cnt_max notValidatedCount = 0;
         uint_reads_cnt_max errorsCount = 0;
         if (preserveOrderMode) {
-            rlIdxOrder = getAllPgsOrgIdxs2RlIdx();
-            for(uint_reads_cnt_std i = 0; i < readsTotalCount; i++) {
-                uint_reads_cnt_std rlIdx = rlIdxOrder[i];
+            const ReadsIndexesVector orgIdx2rlIdx = getAllPgsOrgIdxs2RlIdx();
+            for(uint_reads_cnt_max i = 0; i < readsTotalCount; i++) {
+                uint_reads_cnt_max rlIdx = orgIdx2rlIdx[i];
                 if (validated[rlIdx]) {
                     notValidatedCount++;
                     continue;
@@ -940,18 +968,18 @@ namespace PgTools {
                     errorsCount++;
             }
         } else {
-            for(uint_reads_cnt_std p = 0; p < readsTotalCount / 2; p++) {
-                uint_reads_cnt_std rlIdx = rlIdxOrder[p * 2];
-                uint_reads_cnt_std rlPairIdx = rlIdxOrder[p * 2 + 1];
+            for(uint_reads_cnt_max p = 0; p < readsTotalCount / 2; p++) {
+                uint_reads_cnt_max rlIdx = rlIdxOrder[p * 2];
+                uint_reads_cnt_max rlPairIdx = rlIdxOrder[p * 2 + 1];
                 if (validated[rlIdx]) notValidatedCount++;
                 if (validated[rlPairIdx]) notValidatedCount++;
                 if (!validated[rlIdx] && !validated[rlPairIdx]) {
                     validated[rlIdx] = true;
                     validated[rlPairIdx] = true;
-                    uint_reads_cnt_std orgIdx = getAllPgsOrgIdx(rlIdx);
-                    uint_reads_cnt_std orgPairIdx = getAllPgsOrgIdx(rlPairIdx);
-                    uint_reads_cnt_std smallerIdx = orgIdx < orgPairIdx ? orgIdx : orgPairIdx;
-                    uint_reads_cnt_std largerIdx = orgIdx >= orgPairIdx ? orgIdx : orgPairIdx;
+                    uint_reads_cnt_max orgIdx = getAllPgsOrgIdx(rlIdx);
+                    uint_reads_cnt_max orgPairIdx = getAllPgsOrgIdx(rlPairIdx);
+                    uint_reads_cnt_max smallerIdx = orgIdx < orgPairIdx ? orgIdx : orgPairIdx;
+                    uint_reads_cnt_max largerIdx = orgIdx >= orgPairIdx ? orgIdx : orgPairIdx;
                     if (largerIdx - smallerIdx != 1 || smallerIdx % 2)
                         errorsCount++;
                     else if (!ignorePairOrderInformation && smallerIdx != orgIdx)
@@ -970,7 +998,7 @@ namespace PgTools {
     template<typename uint_pg_len>
     void PgRCManager::applyRevComplPairFileToPgs(vector<uint_pg_len> &orgIdx2PgPos) {
         if (preserveOrderMode) {
-            uint_reads_cnt_std hqRlIdx = 0;
+            uint_reads_cnt_max hqRlIdx = 0;
             const uint_reads_cnt_max pairsCount = readsTotalCount / 2;
             for (uint_reads_cnt_max i = 0; i < pairsCount; i++) {
                     uint_pg_len pgPos = orgIdx2PgPos[i];
@@ -986,7 +1014,7 @@ namespace PgTools {
             }
         } else {
             for (uint_reads_cnt_max i = 1; i < readsTotalCount; i += 2) {
-                uint_reads_cnt_std idx = rlIdxOrder[i];
+                uint_reads_cnt_max idx = rlIdxOrder[i];
                 if (idx < hqReadsCount)
                     hqPg->getReadsList()->revComp[idx] = !hqPg->getReadsList()->revComp[idx];
             }
@@ -1045,6 +1073,7 @@ namespace PgTools {
                 SeparatedPseudoGenomePersistence::decompressReadsPgPositions<uint_pg_len_max>(pgrcIn, orgIdx2PgPos,
                         readsTotalCount, singleReadsMode);
         } else {
+            rlIdxOrder.fitReadsCount(readsTotalCount);
             SeparatedPseudoGenomePersistence::decompressReadsOrder(pgrcIn, rlIdxOrder,
                                                                    preserveOrderMode, ignorePairOrderInformation, singleReadsMode);
         }
@@ -1085,14 +1114,6 @@ namespace PgTools {
         readLength = hqPg->getReadsSetProperties()->maxReadLength;
     }
 
-    uint_read_len_max probeReadsLength(const string &srcFastqFile) {
-        ReadsSourceIteratorTemplate<uint_read_len_max> *readsIt = ReadsSetPersistence::createManagedReadsIterator(
-                srcFastqFile);
-        readsIt->moveNext();
-        uint_read_len_max readsLength = readsIt->getReadLength();
-        delete(readsIt);
-        return readsLength;
-    }
 
 
 }
\ No newline at end of file
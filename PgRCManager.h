@@ -86,16 +86,18 @@ namespace PgTools {
         uint8_t stageCount;
         fstream pgrcOut;
 
+        PackedConstantLengthReadsSet *allReadsSet = 0;
+        vector<uint8_t> readsQualityClass;
         DividedPCLReadsSets *divReadsSets = 0;
         SeparatedPseudoGenome *hqPg = 0;
         SeparatedPseudoGenome *lqPg = 0;
         SeparatedPseudoGenome *nPg = 0;
 
-        vector<uint_reads_cnt_std> rlIdxOrder;
+        ReadsIndexesVector rlIdxOrder;
         vector<uint_pg_len_max> orgIdx2PgPos;
         vector<uint_pg_len_std> orgIdx2StdPgPos;
 
-        bool revComplPairFile;
+        bool revComplPairFile = false;
         bool qualityDivision;
         bool generatorDivision;
         string lqDivisionFile;
@@ -296,6 +298,13 @@ namespace PgTools {
             PgRCManager::endAtStage = endAtStage;
         }
 
+        void loadAllReads();
+
+        ReadsSourceIteratorTemplate<uint_read_len_max> *createAllReadsIterator();
+
+        void disposeAllReads();
+        void releaseAllReads();
+
         void runQualityBasedDivision();
 
         void runPgGeneratorBasedReadsDivision();
@@ -374,7 +383,7 @@ namespace PgTools {
 
         uint_reads_cnt_max dnaStreamSize() const;
 
-        const vector<uint_reads_cnt_max> getAllPgsOrgIdxs2RlIdx() const;
+        const ReadsIndexesVector getAllPgsOrgIdxs2RlIdx() const;
         const uint_reads_cnt_max getAllPgsOrgIdx(uint_reads_cnt_max idx) const;
 
         void preparePgsForValidation() const;
@@ -6,7 +6,32 @@ DefaultConstantLengthPatternsOnTextHashMatcher::DefaultConstantLengthPatternsOnT
 }
 
 DefaultConstantLengthPatternsOnTextHashMatcher::~DefaultConstantLengthPatternsOnTextHashMatcher() {
+    PgSAHelpers::freeLargeArray(slots, slotsCount * sizeof(uint64_t));
+}
 
+void DefaultConstantLengthPatternsOnTextHashMatcher::addPatternHash(uint32_t hash, uint32_t idx) {
+    if (idx == UINT32_MAX) {
+        fprintf(stderr, "Pattern index %u out of range\n", idx);
+        exit(EXIT_FAILURE);
+    }
+    patternsSlots.push_back(((uint64_t) hash << 32) | (idx + 1));
+}
+
+void DefaultConstantLengthPatternsOnTextHashMatcher::buildSlots() {
+    uint8_t slotsBits = MIN_SLOTS_BITS;
+    while ((1ULL << slotsBits) < patternsSlots.size() + patternsSlots.size() / 2)
+        slotsBits++;
+    slotsCount = 1ULL << slotsBits;
+    slotsMask = slotsCount - 1;
+    slotsShift = 64 - slotsBits;
+    slots = (uint64_t*) PgSAHelpers::allocateLargeArray(slotsCount * sizeof(uint64_t));
+    for(const uint64_t patternSlot: patternsSlots) {
+        uint64_t slot = hashToSlot(patternSlot >> 32);
+        while (slots[slot])
+            slot = (slot + 1) & slotsMask;
+        slots[slot] = patternSlot;
+    }
+    vector<uint64_t>().swap(patternsSlots);
 }
 
 void DefaultConstantLengthPatternsOnTextHashMatcher::addPattern(const char *pattern, uint32_t idx) {
@@ -17,7 +42,7 @@ void DefaultConstantLengthPatternsOnTextHashMatcher::addPattern(const char *patt
     hf.reset();
     for(uint32_t i = 0; i < patternLength; i++)
         hf.eat(pattern[i]);
-    hashToIndexMap.insert(std::pair<uint32_t, uint32_t>(hf.hashvalue, idx));
+    addPatternHash(hf.hashvalue, idx);
 }
 
 void DefaultConstantLengthPatternsOnTextHashMatcher::addReadsSetOfPatterns(ConstantLengthReadsSetInterface *readsSet,
@@ -28,6 +53,7 @@ void DefaultConstantLengthPatternsOnTextHashMatcher::addReadsSetOfPatterns(Const
         exit(EXIT_FAILURE);
     }
     const uint_reads_cnt_max readsCount = readsSet->getReadsSetProperties()->readsCount;
+    patternsSlots.reserve(patternsSlots.size() + (uint64_t) readsCount * partsCount);
     for (uint_reads_cnt_max i = 0; i < readsCount; i++) {
         if (!matchedReadsBitmap.empty() && matchedReadsBitmap[i])
             continue;
@@ -36,13 +62,13 @@ void DefaultConstantLengthPatternsOnTextHashMatcher::addReadsSetOfPatterns(Const
             hf.reset();
             for(uint32_t k = 0; k < patternLength; k++)
                 hf.eat(readsSet->getReadSymbol(i, offset + k));
-            hashToIndexMap.insert(std::pair<uint32_t, uint32_t>(hf.hashvalue, i * partsCount + j));
+            addPatternHash(hf.hashvalue, i * partsCount + j);
         }
     }
 }
 
 uint32_t DefaultConstantLengthPatternsOnTextHashMatcher::getHashMatchPatternIndex() {
-    return indexIter->second;
+    return (uint32_t) slots[probeSlot] - 1;
 }
 
 uint64_t DefaultConstantLengthPatternsOnTextHashMatcher::getHashMatchTextPosition() {
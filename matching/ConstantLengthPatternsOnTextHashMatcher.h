@@ -5,12 +5,22 @@
 #include <vector>
 #include "rollinghash/cyclichash.h"
 #include "../readsset/ReadsSetInterface.h"
+#include "../utils/helper.h"
 
 using namespace std;
 
+// Patterns are kept in a flat open-addressing (linear probing) table of 64-bit slots:
+// pattern hash (upper 32 bits) and pattern index + 1 (lower 32 bits; 0 marks an empty slot).
 class DefaultConstantLengthPatternsOnTextHashMatcher {
 private:
-    unordered_multimap<uint32_t, uint32_t> hashToIndexMap;
+    static const uint8_t TEXT_HASHES_BATCH_SIZE = 16;
+    static const uint8_t MIN_SLOTS_BITS = 4;
+
+    vector<uint64_t> patternsSlots;
+    uint64_t* slots = 0;
+    uint64_t slotsCount = 0;
+    uint64_t slotsMask = 0;
+    uint8_t slotsShift = 0;
     const uint32_t patternLength;
 
     CyclicHash<uint32_t> hf;
@@ -20,7 +30,18 @@ private:
 
     //iterator fields
     int64_t txtPos = -1;
-    unordered_multimap<uint32_t, uint32_t>::iterator indexIter, indexIterEnd;
+    uint32_t currentHash = 0;
+    uint64_t probeSlot = 0;
+    int64_t batchBegin = 0;
+    int64_t batchEnd = 0;
+    uint32_t batchHashes[TEXT_HASHES_BATCH_SIZE];
+    uint64_t batchSlots[TEXT_HASHES_BATCH_SIZE];
+
+    inline uint64_t hashToSlot(uint32_t hash) const { return (hash * 0x9E3779B97F4A7C15ULL) >> slotsShift; }
+    void addPatternHash(uint32_t hash, uint32_t idx);
+    void buildSlots();
+    inline void fillTextHashesBatch();
+    inline bool findInProbeChain();
 
 public:
     DefaultConstantLengthPatternsOnTextHashMatcher(uint32_t patternLength);
@@ -40,28 +61,55 @@ public:
 
 
 void DefaultConstantLengthPatternsOnTextHashMatcher::iterateOver(const char *txt, uint64_t length) {
+    if (slots == 0)
+        buildSlots();
     this->txt = txt;
     this->txtSize = length;
     hf.reset();
     for(uint32_t i = 0; i < txtSize && i < patternLength; i++)
         hf.eat(this->txt[i]);
     this->txtPos = -1;
-    indexIter = hashToIndexMap.end();
-    indexIterEnd = hashToIndexMap.end();
+    batchBegin = 0;
+    batchEnd = 0;
+}
+
+// hashes of the next text positions are computed ahead and their slots prefetched before probing
+void DefaultConstantLengthPatternsOnTextHashMatcher::fillTextHashesBatch() {
+    const int64_t lastPos = (int64_t) txtSize - patternLength;
+    batchBegin = this->txtPos;
+    batchEnd = batchBegin + TEXT_HASHES_BATCH_SIZE <= lastPos ? batchBegin + TEXT_HASHES_BATCH_SIZE : lastPos + 1;
+    for(int64_t pos = batchBegin; pos < batchEnd; pos++) {
+        const uint8_t b = pos - batchBegin;
+        batchHashes[b] = hf.hashvalue;
+        batchSlots[b] = hashToSlot(hf.hashvalue);
+        __builtin_prefetch(slots + batchSlots[b]);
+        if (pos < lastPos)
+            hf.update(this->txt[pos], this->txt[pos + patternLength]);
+    }
+}
+
+bool DefaultConstantLengthPatternsOnTextHashMatcher::findInProbeChain() {
+    while (slots[probeSlot]) {
+        if ((uint32_t) (slots[probeSlot] >> 32) == currentHash)
+            return true;
+        probeSlot = (probeSlot + 1) & slotsMask;
+    }
+    return false;
 }
 
 bool DefaultConstantLengthPatternsOnTextHashMatcher::moveNext() {
-    if (indexIter != indexIterEnd) {
-        indexIter++;
-        if (indexIter != indexIterEnd)
+    if (this->txtPos >= batchBegin && this->txtPos < batchEnd && slots[probeSlot]) {
+        probeSlot = (probeSlot + 1) & slotsMask;
+        if (findInProbeChain())
             return true;
     }
     while(++this->txtPos <= (int64_t) txtSize - patternLength) {
-        auto indexIterRange = hashToIndexMap.equal_range(hf.hashvalue);
-        hf.update(this->txt[this->txtPos], this->txt[this->txtPos + patternLength]);
-        indexIter = indexIterRange.first;
-        indexIterEnd = indexIterRange.second;
-        if (indexIter != indexIterEnd)
+        if (this->txtPos == batchEnd)
+            fillTextHashesBatch();
+        const uint8_t b = this->txtPos - batchBegin;
+        currentHash = batchHashes[b];
+        probeSlot = batchSlots[b];
+        if (findInProbeChain())
             return true;
     }
     return false;
@@ -151,9 +151,7 @@ namespace PgTools {
         missedReadsDest.close();
         dumpDest.close();
     }
-    void DefaultReadsMatcher::matchConstantLengthReads() {
-        initMatching();
-
+    void DefaultReadsMatcher::executeBothStrandsMatching() {
         this->executeMatching(false);
 
         if (revComplPg) {
@@ -163,16 +161,14 @@ namespace PgTools {
         }
     }
 
+    void DefaultReadsMatcher::matchConstantLengthReads() {
+        initMatching();
+        this->executeBothStrandsMatching();
+    }
+
     void AbstractReadsApproxMatcher::continueMatchingConstantLengthReads(DefaultReadsMatcher *pMatcher) {
         this->initMatchingContinuation(pMatcher);
-
-        this->executeMatching(false);
-
-        if (revComplPg) {
-            PgSAHelpers::reverseComplementInPlace(pgPtr, pgLength);
-            this->executeMatching(true);
-            PgSAHelpers::reverseComplementInPlace(pgPtr, pgLength);
-        }
+        this->executeBothStrandsMatching();
     }
 
     DefaultReadsExactMatcher::DefaultReadsExactMatcher(char* pgPtr, const uint_pg_len_max pgLength, bool revComplPg,
@@ -410,35 +406,47 @@ namespace PgTools {
         AbstractReadsApproxMatcher::initMatchingContinuation(pMatcher);
     }
 
-    void CopMEMReadsApproxMatcher::executeMatching(bool revCompMode) {
+    void CopMEMReadsApproxMatcher::executeBothStrandsMatching() {
         time_checkpoint();
-        cout << "Feeding " << (revCompMode?"rc of ":"") << "pseudogenome sequence... " << endl;
-        CopMEMMatcher* copMEMMatcher = new CopMEMMatcher(pgPtr, pgLength, partLength);
+        cout << "Feeding pseudogenome sequence... " << endl;
+        copMEMMatcher = new CopMEMMatcher(pgPtr, pgLength, partLength);
         *logout << "... checkpoint " << time_millis() << " msec. " << endl;
+        this->executeMatching(revComplPg);
+        delete(copMEMMatcher);
+        copMEMMatcher = 0;
+    }
+
+    void CopMEMReadsApproxMatcher::executeMatching(bool revCompMode) {
         #pragma omp parallel for reduction(+:matchedReadsCount) reduction(+:betterMatchCount) \
                                 reduction(+:falseMatchCount) reduction(+:matchedCountPerMismatches[0:NOT_MATCHED_COUNT+1])
         for(uint_reads_cnt_max matchReadIndex = 0; matchReadIndex < readsCount; matchReadIndex++) {
-            char_pg currentReadPtr[UINT8_MAX];
-            if (readMismatchesCount[matchReadIndex] <= minMismatches)
-                continue;
-            readsSet->getRead(matchReadIndex, currentReadPtr);
-            uint8_t mismatchesCount = readMismatchesCount[matchReadIndex];
-            uint64_t matchPosition = copMEMMatcher->approxMatchPattern(currentReadPtr, matchingLength,
-                                                                       maxMismatches, minMismatches, mismatchesCount,
-                                                                       betterMatchCount, falseMatchCount);
-            if (matchPosition == UINT64_MAX)
-                continue;
-            if (mismatchesCount < readMismatchesCount[matchReadIndex]) {
-                if (readMismatchesCount[matchReadIndex] == NOT_MATCHED_COUNT)
-                    matchedReadsCount++;
-                matchedCountPerMismatches[readMismatchesCount[matchReadIndex]]--;
-                matchedCountPerMismatches[mismatchesCount]++;
-                readMatchPos[matchReadIndex] = revCompMode?pgLength-(matchPosition+matchingLength):matchPosition;
-                readMatchRC[matchReadIndex] = revCompMode;
-                readMismatchesCount[matchReadIndex] = mismatchesCount;
+            char_pg currentReadPtr[USHRT_MAX];
+            // the reverse complement of a read matching the pseudogenome at some position
+            // is equivalent to the read matching the reverse complemented pseudogenome
+            for (uint8_t rcPass = 0; rcPass <= (revCompMode ? 1 : 0); rcPass++) {
+                if (readMismatchesCount[matchReadIndex] <= minMismatches)
+                    break;
+                if (rcPass)
+                    reverseComplementInPlace(currentReadPtr, matchingLength);
+                else
+                    readsSet->getRead(matchReadIndex, currentReadPtr);
+                uint8_t mismatchesCount = readMismatchesCount[matchReadIndex];
+                uint64_t matchPosition = copMEMMatcher->approxMatchPattern(currentReadPtr, matchingLength,
+                                                                           maxMismatches, minMismatches, mismatchesCount,
+                                                                           betterMatchCount, falseMatchCount);
+                if (matchPosition == UINT64_MAX)
+                    continue;
+                if (mismatchesCount < readMismatchesCount[matchReadIndex]) {
+                    if (readMismatchesCount[matchReadIndex] == NOT_MATCHED_COUNT)
+                        matchedReadsCount++;
+                    matchedCountPerMismatches[readMismatchesCount[matchReadIndex]]--;
+                    matchedCountPerMismatches[mismatchesCount]++;
+                    readMatchPos[matchReadIndex] = matchPosition;
+                    readMatchRC[matchReadIndex] = rcPass;
+                    readMismatchesCount[matchReadIndex] = mismatchesCount;
+                }
             }
         }
-        delete(copMEMMatcher);
         printApproxMatchingStats();
     }
 
@@ -551,18 +559,27 @@ namespace PgTools {
 
     void AbstractReadsApproxMatcher::closeEntryUpdating() { }
 
-    void DefaultReadsMatcher::exportMatchesInPgOrder(SeparatedPseudoGenome* sPg, ostream &pgrcOut, uint8_t compressionLevel,
-                                                     const string &outPgPrefix, IndexesMapping *orgIndexesMapping,
-                                                     bool pairFileMode, bool revComplPairFile) {
-        time_checkpoint();
-        vector<uint_reads_cnt_max> idxs(matchedReadsCount);
+    template<typename uint_reads_cnt>
+    void DefaultReadsMatcher::fillMatchedReadsIdxsInPgOrder(vector<uint_reads_cnt> &idxs) {
+        idxs.resize(matchedReadsCount);
         uint64_t counter = 0;
         for(uint_reads_cnt_max i = 0; i < readsCount; i++)
             if (readMatchPos[i] != NOT_MATCHED_POSITION)
                 idxs[counter++] = i;
 
-        __gnu_parallel::sort(idxs.begin(), idxs.end(), [this](const uint_reads_cnt_max& idx1, const uint_reads_cnt_max& idx2) -> bool
+        __gnu_parallel::sort(idxs.begin(), idxs.end(), [this](const uint_reads_cnt& idx1, const uint_reads_cnt& idx2) -> bool
         { return readMatchPos[idx1] < readMatchPos[idx2]; });
+    }
+
+    void DefaultReadsMatcher::exportMatchesInPgOrder(SeparatedPseudoGenome* sPg, ostream &pgrcOut, uint8_t compressionLevel,
+                                                     const string &outPgPrefix, IndexesMapping *orgIndexesMapping,
+                                                     bool pairFileMode, bool revComplPairFile) {
+        time_checkpoint();
+        ReadsIndexesVector idxs(readsCount);
+        if (idxs.isNarrow())
+            fillMatchedReadsIdxsInPgOrder(idxs.getNarrowVector());
+        else
+            fillMatchedReadsIdxsInPgOrder(idxs.getWideVector());
 
         initEntryUpdating();
         SeparatedPseudoGenomeOutputBuilder* builder = this->createSeparatedPseudoGenomeOutputBuilder(sPg);
@@ -591,11 +608,11 @@ namespace PgTools {
                                                            bool revComplPairFile) {
         time_checkpoint();
 
-        uint_reads_cnt_std readsTotalCount = orgIndexesMapping->getReadsTotalCount();
+        uint_reads_cnt_max readsTotalCount = orgIndexesMapping->getReadsTotalCount();
         vector<uint_pg_len_max> orgIdx2pgPos(readsTotalCount, -1);
         ExtendedReadsListWithConstantAccessOption *const pgRl = sPg->getReadsList();
         uint_pg_len_max pos = 0;
-        for(uint_reads_cnt_std i = 0; i < pgRl->readsCount; i++) {
+        for(uint_reads_cnt_max i = 0; i < pgRl->readsCount; i++) {
             pos += pgRl->off[i];
             orgIdx2pgPos[pgRl->orgIdx[i]] = pos;
         }
@@ -605,7 +622,7 @@ namespace PgTools {
         SeparatedPseudoGenomeOutputBuilder* builder = this->createSeparatedPseudoGenomeOutputBuilder(sPg);
         uint_reads_cnt_max nI_start = readsCount;
         int64_t curOrgIdx = 0;
-        for(uint_reads_cnt_std i = 0; i < readsCount; i++) {
+        for(uint_reads_cnt_max i = 0; i < readsCount; i++) {
             const uint_reads_cnt_max oIdx = orgIndexesMapping->getReadOriginalIndex(i);
             if (curOrgIdx > oIdx) {
                 nI_start = i;
@@ -688,7 +705,8 @@ namespace PgTools {
                         char matchingMode, bool dumpInfo, ostream &pgrcOut, uint8_t compressionLevel,
                         const string &pgDestFilePrefix, IndexesMapping* orgIndexesMapping) {
         uint_read_len_max readLength = readsSet->maxReadLength();
-        uint8_t maxMismatches = readLength / minCharsPerMismatch;
+        uint8_t maxMismatches = readLength / minCharsPerMismatch < NOT_MATCHED_COUNT ?
+                readLength / minCharsPerMismatch : NOT_MATCHED_COUNT - 1;
         if (readsExactMatchingChars > readLength)
             readsExactMatchingChars = readLength;
         if (preReadsExactMatchingChars > readLength)
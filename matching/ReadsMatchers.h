@@ -44,6 +44,8 @@ namespace PgTools {
 
         virtual void initMatching();
         virtual void executeMatching(bool revCompMode = false) = 0;
+        // matches reads to the pseudogenome and (if revComplPg) to its reverse complement
+        virtual void executeBothStrandsMatching();
         virtual void writeMatchesInfo(ofstream &offsetsDest, ofstream &missedPatternsDest, ofstream &suffixesDest) = 0;
 
         virtual SeparatedPseudoGenomeOutputBuilder *createSeparatedPseudoGenomeOutputBuilder(
@@ -53,6 +55,9 @@ namespace PgTools {
         virtual void updateEntry(DefaultReadsListEntry &entry, uint_reads_cnt_max matchIdx, bool revComplPairFile) = 0;
         virtual void closeEntryUpdating() = 0;
 
+        template<typename uint_reads_cnt>
+        void fillMatchedReadsIdxsInPgOrder(vector<uint_reads_cnt> &idxs);
+
     public:
         static const uint_read_len_max DISABLED_PREFIX_MODE;
         static const uint64_t NOT_MATCHED_POSITION;
@@ -183,12 +188,15 @@ namespace PgTools {
 
     class CopMEMReadsApproxMatcher: public AbstractReadsApproxMatcher {
     private:
+        CopMEMMatcher* copMEMMatcher = 0;
 
     protected:
         uint_read_len_max partLength;
 
         void initMatching();
+        // revCompMode - reverse complements of reads are matched as well (using the same pseudogenome index)
         void executeMatching(bool revCompMode = false);
+        void executeBothStrandsMatching() override;
 
         void initMatchingContinuation(DefaultReadsMatcher *pMatcher) override;
 
@@ -44,6 +44,10 @@
 #include "Hashes.h"
 #include <omp.h>
 
+#ifdef X86_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
 //////////////////// GLOBAL CONSTS //////////////////////////
 const uint64_t NOT_MATCHED_POSITION = UINT64_MAX;
 
@@ -229,95 +233,84 @@ HashBuffer<MyUINT1, MyUINT2> CopMEMMatcher::processRef() {
     return { sampledPositions, cumm };
 }
 
-template<typename MyUINT2>
-void CopMEMMatcher::genCummMultithreaded(size_t N, const char* gen, uint8_t* counts, MyUINT2* cumm) {
-	const size_t MULTI1 = 128;
-	const size_t k1MULTI1 = k1 * MULTI1;
-
-	#pragma omp parallel for
-    for (size_t i = 0; i < N - K - k1MULTI1; i += k1MULTI1) {
-        uint32_t hashPositions[MULTI1];
-		const char* tempPointer = gen + i;
-		for (size_t temp = 0; temp < MULTI1; ++temp) {
-			hashPositions[temp] = hashFunc(tempPointer);
-			tempPointer += k1;
-			_prefetch((char*)(counts + hashPositions[temp]), 1);
-		}
-
-        for (size_t temp = 0; temp < MULTI1; ++temp) {
-            {
-                if (counts[hashPositions[temp]] <= HASH_COLLISIONS_PER_POSITION_LIMIT)
-                    ++counts[hashPositions[temp]];
-            }
-        }
-	}
-
-	//////////////////// processing the end part of R  //////////////////////
-	for (size_t i = ((N - K - 1) / k1MULTI1) * k1MULTI1; i < N - K + 1; i += k1) {
-		uint32_t h = hashFunc(gen + i);
-		if (counts[h] <= HASH_COLLISIONS_PER_POSITION_LIMIT)
-		    ++counts[h];
-	}
-	//////////////////// processing the end part of R //////////////////////
-    MyUINT2 sum = 0;
-    for(size_t i = 0; i < hash_size + 1; i++) {
-        cumm[i] = sum;
-        sum += counts[i];
-    }
-    cumm[hash_size + 1] = sum;
-}
-
+// sampled positions are distributed (in order) to shards of hash values by a two-pass radix partitioning, then
+// each shard keeps the first positions of its buckets (as processRef does), so the index is independent of threads count
 template<typename MyUINT1, typename MyUINT2>
 HashBuffer<MyUINT1, MyUINT2> CopMEMMatcher::processRefMultithreaded() {
+    const size_t positionsCount = N < K ? 0 : (N - K) / k1 + 1;
+    const int threadsCount = PgSAHelpers::numberOfThreads;
+    int hashOrder = 0;
+    while (((size_t) 1 << hashOrder) < hash_size)
+        hashOrder++;
+    const int shardsOrder = hashOrder < HASH_SHARDS_MAX_ORDER ? hashOrder : HASH_SHARDS_MAX_ORDER;
+    const int shardShift = hashOrder - shardsOrder;
+    const size_t shardsCount = (size_t) 1 << shardsOrder;
+    const size_t bucketsPerShard = (size_t) 1 << shardShift;
+
+    vector<vector<size_t>> threadShardPos(threadsCount, vector<size_t>(shardsCount, 0));
+    #pragma omp parallel for
+    for (int t = 0; t < threadsCount; t++) {
+        const size_t endIdx = positionsCount * (t + 1) / threadsCount;
+        for (size_t j = positionsCount * t / threadsCount; j < endIdx; j++)
+            threadShardPos[t][hashFunc(start1 + j * k1) >> shardShift]++;
+    }
+    vector<size_t> shardBegin(shardsCount + 1, 0);
+    size_t pos = 0;
+    for (size_t s = 0; s < shardsCount; s++) {
+        shardBegin[s] = pos;
+        for (int t = 0; t < threadsCount; t++) {
+            const size_t count = threadShardPos[t][s];
+            threadShardPos[t][s] = pos;
+            pos += count;
+        }
+    }
+    shardBegin[shardsCount] = pos;
+    MyUINT1* shardPositions = new MyUINT1[positionsCount + 1];
+    #pragma omp parallel for
+    for (int t = 0; t < threadsCount; t++) {
+        const size_t endIdx = positionsCount * (t + 1) / threadsCount;
+        for (size_t j = positionsCount * t / threadsCount; j < endIdx; j++)
+            shardPositions[threadShardPos[t][hashFunc(start1 + j * k1) >> shardShift]++] = j * k1;
+    }
+    vector<vector<size_t>>().swap(threadShardPos);
 
-	const unsigned int MULTI2 = 128;
-	const unsigned int k1MULTI2 = k1 * MULTI2;
-
-	MyUINT2* cumm = new MyUINT2[hash_size + 2]();
-    uint8_t* counts = new uint8_t[hash_size + 2]();
-	genCummMultithreaded(N, start1, counts, cumm);
-    const size_t hashCount = cumm[hash_size + 1];
+    MyUINT2* cumm = new MyUINT2[hash_size + 2]();
+    vector<size_t> shardHashCount(shardsCount + 1, 0);
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t s = 0; s < shardsCount; s++) {
+        for (size_t i = shardBegin[s]; i < shardBegin[s + 1]; i++) {
+            const uint32_t h = hashFunc(start1 + shardPositions[i]);
+            if (cumm[h] <= HASH_COLLISIONS_PER_POSITION_LIMIT)
+                ++cumm[h];
+        }
+        shardHashCount[s + 1] = std::accumulate(cumm + s * bucketsPerShard, cumm + (s + 1) * bucketsPerShard, (size_t) 0);
+    }
+    std::partial_sum(shardHashCount.begin(), shardHashCount.end(), shardHashCount.begin());
+    const size_t hashCount = shardHashCount[shardsCount];
     MyUINT1* sampledPositions = new MyUINT1[hashCount + 2];
+    sampledPositions[hashCount] = 0;
+    sampledPositions[hashCount + 1] = 0;
     *v1logger << "Hash count = " << hashCount << std::endl;
 
-    #pragma omp parallel for
-	for (MyUINT1 i1 = 0; i1 < N - K - k1MULTI2 ; i1 += k1MULTI2) {
-        uint32_t hashPositions[MULTI2];
-		const char* tempPointer = start1 + i1;
-		for (unsigned int temp = 0; temp < MULTI2; ++temp) {
-		    hashPositions[temp] = hashFunc(tempPointer);
-			tempPointer += k1;
-            _prefetch((char*)(counts + hashPositions[temp]), 1);
-			_prefetch((char*)(cumm + hashPositions[temp]), 1);
-		}
-
-		for (unsigned int temp = 0; temp < MULTI2; ++temp) {
-			_prefetch((char*)(sampledPositions + *(cumm + hashPositions[temp])), 1);
-		}
-
-		MyUINT1 i2 = i1;
-		for (size_t temp = 0; temp < MULTI2; ++temp, i2 += k1) {
-            if (!counts[hashPositions[temp]])
-                continue;
-			sampledPositions[cumm[hashPositions[temp]] + (--counts[hashPositions[temp]])] = i2;
-		}
-	}
-
-	//////////////////// processing the end part of R
-	for (MyUINT1 i1 = ((N - K - 1) / k1MULTI2) * k1MULTI2; i1 < N - K + 1; i1 += k1) {
-        uint32_t h = hashFunc(start1 + i1);
-	    if (!counts[h])
-            continue;
-		sampledPositions[cumm[h] + (--counts[h])] = i1;
-	}
-	delete[] counts;
-
-    #pragma omp parallel for
-	for (size_t i = 0; i < hashCount + 2; i++) {
-	    if (sampledPositions[i] > N - K)
-	        sampledPositions[i] = 0;
-	}
-
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t s = 0; s < shardsCount; s++) {
+        const size_t firstBucket = s * bucketsPerShard;
+        vector<uint8_t> bucketFill(bucketsPerShard, 0);
+        MyUINT2 bucketStart = shardHashCount[s];
+        for (size_t h = firstBucket; h < firstBucket + bucketsPerShard; h++) {
+            const MyUINT2 count = cumm[h];
+            cumm[h] = bucketStart;
+            bucketStart += count;
+        }
+        for (size_t i = shardBegin[s]; i < shardBegin[s + 1]; i++) {
+            const uint32_t h = hashFunc(start1 + shardPositions[i]);
+            if (bucketFill[h - firstBucket] <= HASH_COLLISIONS_PER_POSITION_LIMIT)
+                sampledPositions[cumm[h] + bucketFill[h - firstBucket]++] = shardPositions[i];
+        }
+    }
+    cumm[hash_size] = hashCount;
+    cumm[hash_size + 1] = hashCount;
+    delete[] shardPositions;
 
 	return { sampledPositions, cumm };
 }
@@ -329,10 +322,12 @@ void CopMEMMatcher::deleteHashBuffer(HashBuffer<MyUINT1, MyUINT2> & buf) {
 }
 
 template<typename MyUINT1, typename MyUINT2>
-void CopMEMMatcher::processExactMatchQueryTight(HashBuffer<MyUINT1, MyUINT2> buffer, vector<TextMatch> &resMatches,
-                                                const string &destText, bool destIsSrc, bool revComplMatching,
-                                                uint32_t minMatchLength){
-	const unsigned int MULTI = 256;
+size_t CopMEMMatcher::scanExactMatchesTight(HashBuffer<MyUINT1, MyUINT2> buffer, vector<TextMatch> &resMatches,
+                                           const string &destText, bool destIsSrc, bool revComplMatching,
+                                           uint32_t minMatchLength, size_t firstBatch, size_t lastBatch,
+                                           bool withEndPart, ExactMatchScanState &state,
+                                           vector<ExactMatchScanState> *batchStates) {
+	const unsigned int MULTI = EXACT_MATCH_QUERY_BATCH_SIZE;
 	const unsigned int k2MULTI = k2 * MULTI;
 
 	MyUINT1* sampledPositions = buffer.first;
@@ -341,7 +336,7 @@ void CopMEMMatcher::processExactMatchQueryTight(HashBuffer<MyUINT1, MyUINT2> buf
 	uint32_t hArray[MULTI];
 	MyUINT2 posArray[MULTI * 2];
 
-	std::uint32_t l1 = 0, l2 = 0, r1 = 0, r2 = 0;
+	std::uint32_t l1 = 0, l2 = state.l2, r1 = 0, r2 = state.r2;
 
 	size_t charExtensions = 0ULL;
 
@@ -350,81 +345,78 @@ void CopMEMMatcher::processExactMatchQueryTight(HashBuffer<MyUINT1, MyUINT2> buf
 
     const int skip = K / k1 - k2;
     const int skipK2 = skip * k2;
-    const bool MULTI_MODE = true;
-    *v1logger << "Minimal matching length = " << minMatchLength << "; ";
-    *v1logger << "Skip factor = " << skip << "; ";
-    *v1logger << "Multi-mode = " << (MULTI_MODE?"true":"false") << std::endl;
 
-    size_t i1 = 0;
     const char* end1 = start1 + N;
     const char* end2 = start2 + N2;
-    if (MULTI_MODE) {
-        for (i1 = 0; i1 + K + k2MULTI < N2 + 1; i1 += k2MULTI) {
-            const char *curr2 = start2 + i1;
-            size_t tempCount = 0;
-            for (size_t i2 = 0; i2 < MULTI; ++i2) {
-                hArray[tempCount++] = hashFunc(curr2);
+    for (size_t b = firstBatch; b < lastBatch; b++) {
+        const size_t i1 = b * k2MULTI;
+        const char *curr2 = start2 + i1;
+        size_t tempCount = 0;
+        for (size_t i2 = 0; i2 < MULTI; ++i2) {
+            hArray[tempCount++] = hashFunc(curr2);
+            curr2 += k2;
+        }
+        for (size_t i2 = 0; i2 < tempCount; ++i2) {
+            memcpy(posArray + i2 * 2, cumm + hArray[i2], sizeof(MyUINT2) * 2);
+        }
+
+        curr2 = start2 + i1;
+        for (size_t i2 = 0; i2 < tempCount; ++i2) {
+            if (posArray[i2 * 2] == posArray[i2 * 2 + 1]) {
                 curr2 += k2;
-            }
-            for (size_t i2 = 0; i2 < tempCount; ++i2) {
-                memcpy(posArray + i2 * 2, cumm + hArray[i2], sizeof(MyUINT2) * 2);
+                continue;
             }
 
-            curr2 = start2 + i1;
-            for (size_t i2 = 0; i2 < tempCount; ++i2) {
-                if (posArray[i2 * 2] == posArray[i2 * 2 + 1]) {
-                    curr2 += k2;
+            if (curr2 - LK2 >= start2) memcpy(&l2, curr2 - LK2, sizeof(std::uint32_t));
+            if (curr2 + K_PLUS_LK24 + sizeof(std::uint32_t) <= end2) memcpy(&r2, curr2 + K_PLUS_LK24, sizeof(std::uint32_t));
+
+            for (MyUINT1 j = posArray[i2 * 2]; j < posArray[i2 * 2 + 1]; ++j) {
+                ++charExtensions;
+                const char *curr1 = start1 + sampledPositions[j];
+
+                uint64_t tmpMatchSrcPos = sampledPositions[j];
+                uint64_t tmpMatchDestPos = curr2 - start2;
+                if (destIsSrc && (revComplMatching ? destText.length() - tmpMatchSrcPos < tmpMatchDestPos
+                                                   : curr2 - start2 >= tmpMatchSrcPos))
                     continue;
+                if (resMatches.size() > 0 &&
+                    tmpMatchDestPos - tmpMatchSrcPos == resMatches.back().posDestText - resMatches.back().posSrcText
+                    && tmpMatchDestPos + K < resMatches.back().posDestText + resMatches.back().length) {
+                    curr2 += skipK2;
+                    i2 += skip;
+                    break;
                 }
 
-                if (curr2 - LK2 >= start2) memcpy(&l2, curr2 - LK2, sizeof(std::uint32_t));
-                if (curr2 + K_PLUS_LK24 + sizeof(std::uint32_t) <= end2) memcpy(&r2, curr2 + K_PLUS_LK24, sizeof(std::uint32_t));
-
-                for (MyUINT1 j = posArray[i2 * 2]; j < posArray[i2 * 2 + 1]; ++j) {
-                    ++charExtensions;
-                    const char *curr1 = start1 + sampledPositions[j];
-
-                    uint64_t tmpMatchSrcPos = sampledPositions[j];
-                    uint64_t tmpMatchDestPos = curr2 - start2;
-                    if (destIsSrc && (revComplMatching ? destText.length() - tmpMatchSrcPos < tmpMatchDestPos
-                                                       : curr2 - start2 >= tmpMatchSrcPos))
-                        continue;
-                    if (resMatches.size() > 0 &&
-                        tmpMatchDestPos - tmpMatchSrcPos == resMatches.back().posDestText - resMatches.back().posSrcText
-                        && tmpMatchDestPos + K < resMatches.back().posDestText + resMatches.back().length) {
+                memcpy(&l1, curr1 - LK2, sizeof(std::uint32_t));
+                memcpy(&r1, curr1 + K_PLUS_LK24, sizeof(std::uint32_t));
+
+                if (r1 == r2 || l1 == l2) {
+                    const char *p1 = curr1 + K - 1;
+                    const char *p2 = curr2 + K - 1;
+                    while (++p1 != end1 && ++p2 != end2 && *p1 == *p2);
+                    const char *right = p1;
+                    p1 = curr1;
+                    p2 = curr2;
+                    while (p1 != start1 && p2 != start2 && *--p1 == *--p2);
+
+                    if (right - p1 > minMatchLength && memcmp(curr1, curr2, K) == 0) {
+                        resMatches.push_back(TextMatch(p1 + 1 - start1, right - p1 - 1, (p2 + 1 - start2)));
+
                         curr2 += skipK2;
                         i2 += skip;
                         break;
                     }
-
-                    memcpy(&l1, curr1 - LK2, sizeof(std::uint32_t));
-                    memcpy(&r1, curr1 + K_PLUS_LK24, sizeof(std::uint32_t));
-
-                    if (r1 == r2 || l1 == l2) {
-                        const char *p1 = curr1 + K - 1;
-                        const char *p2 = curr2 + K - 1;
-                        while (++p1 != end1 && ++p2 != end2 && *p1 == *p2);
-                        const char *right = p1;
-                        p1 = curr1;
-                        p2 = curr2;
-                        while (p1 != start1 && p2 != start2 && *--p1 == *--p2);
-
-                        if (right - p1 > minMatchLength && memcmp(curr1, curr2, K) == 0) {
-                            resMatches.push_back(TextMatch(p1 + 1 - start1, right - p1 - 1, (p2 + 1 - start2)));
-
-                            curr2 += skipK2;
-                            i2 += skip;
-                            break;
-                        }
-                    }
                 }
-                curr2 += k2;
             }
+            curr2 += k2;
         }
+        if (batchStates)
+            batchStates->push_back({ resMatches.size(), l2, r2 });
     }
     //////////////////// processing the end part of Q  //////////////////////
+    size_t i1 = lastBatch * k2MULTI;
     const char* curr2 = start2 + i1;
-    for (; i1 + K < N2 + 1; i1 += k2) {
+    for (; withEndPart && i1 + K < N2 + 1; i1 += k2) {
         memcpy(posArray, cumm + hashFunc(curr2), sizeof(MyUINT2) * 2);
 
         if (posArray[0] == posArray[1]) {
@@ -476,14 +468,152 @@ void CopMEMMatcher::processExactMatchQueryTight(HashBuffer<MyUINT1, MyUINT2> buf
     }
     //////////////////// processing the end part of Q  //////////////////////
 
+    state = { resMatches.size(), l2, r2 };
+    return charExtensions;
+}
+
+// scans resumed at query position pos behave the same if their cached query words are equal
+// and their last matches are the same or cannot cause skipping any more
+bool CopMEMMatcher::isEquivalentScanState(const vector<TextMatch> &lMatches, const ExactMatchScanState &lState,
+                                          const vector<TextMatch> &rMatches, const ExactMatchScanState &rState,
+                                          size_t pos) {
+    if (lState.l2 != rState.l2 || lState.r2 != rState.r2)
+        return false;
+    const TextMatch* lMatch = lState.matchesCount ? &lMatches[lState.matchesCount - 1] : 0;
+    const TextMatch* rMatch = rState.matchesCount ? &rMatches[rState.matchesCount - 1] : 0;
+    const bool lSkipping = lMatch && pos + K < lMatch->posDestText + lMatch->length;
+    const bool rSkipping = rMatch && pos + K < rMatch->posDestText + rMatch->length;
+    return lSkipping ? rSkipping && *lMatch == *rMatch : !rSkipping;
+}
+
+template<typename MyUINT1, typename MyUINT2>
+void CopMEMMatcher::processExactMatchQueryTight(HashBuffer<MyUINT1, MyUINT2> buffer, vector<TextMatch> &resMatches,
+                                                const string &destText, bool destIsSrc, bool revComplMatching,
+                                                uint32_t minMatchLength){
+    const size_t N2 = destText.length();
+    const size_t k2MULTI = k2 * EXACT_MATCH_QUERY_BATCH_SIZE;
+    const size_t batchesCount = N2 + 1 > K + k2MULTI ? (N2 - K) / k2MULTI : 0;
+    const int skip = K / k1 - k2;
+    *v1logger << "Minimal matching length = " << minMatchLength << "; ";
+    *v1logger << "Skip factor = " << skip << std::endl;
+
+    ExactMatchScanState state = { 0, 0, 0 };
+    size_t charExtensions = 0;
+    if (PgSAHelpers::numberOfThreads == 1 ||
+        batchesCount < (size_t) PgSAHelpers::numberOfThreads * EXACT_MATCH_QUERY_MIN_BATCHES_PER_THREAD) {
+        charExtensions = scanExactMatchesTight(buffer, resMatches, destText, destIsSrc, revComplMatching,
+                                               minMatchLength, 0, batchesCount, true, state, 0);
+        *v1logger << "Character extensions = " << charExtensions <<  "\n";
+        return;
+    }
+
+    // segments are scanned speculatively (from the initial state)...
+    const int segmentsCount = PgSAHelpers::numberOfThreads;
+    vector<vector<TextMatch>> segmentMatches(segmentsCount);
+    vector<vector<ExactMatchScanState>> segmentStates(segmentsCount);
+    #pragma omp parallel for reduction(+:charExtensions)
+    for (int t = 0; t < segmentsCount; t++) {
+        ExactMatchScanState segmentState = { 0, 0, 0 };
+        charExtensions += scanExactMatchesTight(buffer, segmentMatches[t], destText, destIsSrc, revComplMatching,
+                minMatchLength, batchesCount * t / segmentsCount, batchesCount * (t + 1) / segmentsCount,
+                t == segmentsCount - 1, segmentState, &segmentStates[t]);
+    }
+    // ...and joined in order, rescanning batches of a segment until the state of the serial scan is reached
+    resMatches.swap(segmentMatches[0]);
+    state = segmentStates[0].back();
+    for (int t = 1; t < segmentsCount; t++) {
+        const size_t firstBatch = batchesCount * t / segmentsCount;
+        const size_t lastBatch = batchesCount * (t + 1) / segmentsCount;
+        const vector<TextMatch> &matches = segmentMatches[t];
+        const vector<ExactMatchScanState> &states = segmentStates[t];
+        ExactMatchScanState segmentState = { 0, 0, 0 };
+        size_t b = firstBatch;
+        bool converged = isEquivalentScanState(resMatches, state, matches, segmentState, b * k2MULTI);
+        while (!converged && b < lastBatch) {
+            charExtensions += scanExactMatchesTight(buffer, resMatches, destText, destIsSrc, revComplMatching,
+                                                    minMatchLength, b, b + 1, false, state, 0);
+            segmentState = states[b++ - firstBatch];
+            converged = isEquivalentScanState(resMatches, state, matches, segmentState, b * k2MULTI);
+        }
+        if (converged) {
+            resMatches.insert(resMatches.end(), matches.begin() + segmentState.matchesCount, matches.end());
+            state = states.back();
+            state.matchesCount = resMatches.size();
+        } else if (t == segmentsCount - 1)
+            charExtensions += scanExactMatchesTight(buffer, resMatches, destText, destIsSrc, revComplMatching,
+                                                    minMatchLength, lastBatch, lastBatch, true, state, 0);
+        vector<TextMatch>().swap(segmentMatches[t]);
+    }
+
 	*v1logger << "Character extensions = " << charExtensions <<  "\n";
 }
 
+// mismatches counting of pattern and text over length (multiple of 8) bytes;
+// stops (returning a value exceeding maxMismatches) as soon as maxMismatches is exceeded
+static uint32_t countWordsMismatchesScalar(const char* pattern, const char* text, size_t length, uint8_t maxMismatches) {
+    uint32_t res = 0;
+    uint64_t temp1, temp2;
+    for (size_t i = 0; res <= maxMismatches && i < length; i += sizeof(uint64_t)) {
+        memcpy(&temp1, pattern + i, sizeof(uint64_t));
+        memcpy(&temp2, text + i, sizeof(uint64_t));
+        uint64_t temp3 = ((temp1 ^ temp2) + 0x7F7F7F7F7F7F7F7F) & 0x8080808080808080;
+        res += __builtin_popcountll(temp3);
+    }
+    return res;
+}
+
+#ifdef X86_SIMD_DISPATCH
+__attribute__((target("avx2,popcnt")))
+static uint32_t countWordsMismatchesAVX2(const char* pattern, const char* text, size_t length, uint8_t maxMismatches) {
+    uint32_t res = 0;
+    size_t i = 0;
+    for (; res <= maxMismatches && i + 32 <= length; i += 32) {
+        const __m256i patternSymbols = _mm256_loadu_si256((const __m256i*) (pattern + i));
+        const __m256i textSymbols = _mm256_loadu_si256((const __m256i*) (text + i));
+        const uint32_t equalMask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(patternSymbols, textSymbols));
+        res += __builtin_popcount(~equalMask);
+    }
+    if (res > maxMismatches)
+        return res;
+    return res + countWordsMismatchesScalar(pattern + i, text + i, length - i, maxMismatches - res);
+}
+
+__attribute__((target("avx512f,avx512bw,popcnt")))
+static uint32_t countWordsMismatchesAVX512(const char* pattern, const char* text, size_t length, uint8_t maxMismatches) {
+    uint32_t res = 0;
+    size_t i = 0;
+    for (; res <= maxMismatches && i + 64 <= length; i += 64) {
+        const __m512i patternSymbols = _mm512_loadu_si512((const void*) (pattern + i));
+        const __m512i textSymbols = _mm512_loadu_si512((const void*) (text + i));
+        res += __builtin_popcountll(_mm512_cmpneq_epi8_mask(patternSymbols, textSymbols));
+    }
+    if (res > maxMismatches || i == length)
+        return res;
+    const __mmask64 tailMask = _cvtu64_mask64((~0ULL) >> (64 - (length - i)));
+    const __m512i patternSymbols = _mm512_maskz_loadu_epi8(tailMask, (const void*) (pattern + i));
+    const __m512i textSymbols = _mm512_maskz_loadu_epi8(tailMask, (const void*) (text + i));
+    return res + __builtin_popcountll(_mm512_cmpneq_epi8_mask(patternSymbols, textSymbols));
+}
+#endif
+
+typedef uint32_t (*WordsMismatchesCounter)(const char* pattern, const char* text, size_t length, uint8_t maxMismatches);
+
+static WordsMismatchesCounter selectWordsMismatchesCounter() {
+#ifdef X86_SIMD_DISPATCH
+    if (PgSAHelpers::isAVX512BWSupported())
+        return countWordsMismatchesAVX512;
+    if (PgSAHelpers::isAVX2Supported())
+        return countWordsMismatchesAVX2;
+#endif
+    return countWordsMismatchesScalar;
+}
+
 template<typename MyUINT1, typename MyUINT2>
 uint64_t CopMEMMatcher::processApproxMatchQueryTight(HashBuffer<MyUINT1, MyUINT2> buffer, const char *start2,
                                                      const uint_read_len_max N2, uint8_t maxMismatches,
                                                      uint8_t minMismatches, uint8_t &mismatchesCount,
                                                      uint64_t& betterMatchCount, uint64_t& falseMatchCount) {
+    static const WordsMismatchesCounter countWordsMismatches = selectWordsMismatchesCounter();
     if (mismatchesCount < maxMismatches)
         maxMismatches = mismatchesCount - 1;
     MyUINT1* sampledPositions = buffer.first;
@@ -519,23 +649,14 @@ uint64_t CopMEMMatcher::processApproxMatchQueryTight(HashBuffer<MyUINT1, MyUINT2
                 continue;
             const char* curr1 = start1 + sampledPositions[j];
 
-            uint64_t temp1, temp2;
-            uint8_t res = 0;
-            const char* patternPtr = start2;
-            const char* patGuardPtr = start2 + N2trim8;
-            const char* textPtr = curr1 - positionShift;
-            while(res <= maxMismatches && patGuardPtr != patternPtr) {
-                memcpy(&temp1, patternPtr, sizeof(uint64_t));
-                memcpy(&temp2, textPtr, sizeof(uint64_t));
-                uint64_t temp3 = ((temp1 ^ temp2) + 0x7F7F7F7F7F7F7F7F) & 0x8080808080808080;
-                res += __builtin_popcountll(temp3);
-                patternPtr += sizeof(uint64_t);
-                textPtr += sizeof(uint64_t);
-            }
-            if (res > maxMismatches) {
+            const uint32_t wordsRes = countWordsMismatches(start2, curr1 - positionShift, N2trim8, maxMismatches);
+            if (wordsRes > maxMismatches) {
                 currentFalseMatchCount++;
                 continue;
             }
+            uint8_t res = wordsRes;
+            const char* patternPtr = start2 + N2trim8;
+            const char* textPtr = curr1 - positionShift + N2trim8;
             while (patternPtr != start2 + N2) {
                 if (*patternPtr++ != *textPtr++) {
                     if (res++ >= maxMismatches) {
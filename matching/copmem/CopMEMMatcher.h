@@ -13,6 +13,9 @@ static const int AVERAGE_HASH_COLLISIONS_PER_POSITION_LIMIT = 1;
 static const int UNLIMITED_NUMBER_OF_HASH_COLLISIONS_PER_POSITION = 4;
 static const int HASH_SIZE_MIN_ORDER = 24;
 static const int HASH_SIZE_MAX_ORDER = 31;
+static const int HASH_SHARDS_MAX_ORDER = 12;
+static const int EXACT_MATCH_QUERY_BATCH_SIZE = 256;
+static const int EXACT_MATCH_QUERY_MIN_BATCHES_PER_THREAD = 4;
 typedef std::pair<std::string, size_t> SequenceItem;
 typedef std::vector<SequenceItem> SequenceVector;
 
@@ -46,9 +49,6 @@ private:
     template<typename MyUINT1, typename MyUINT2>
     void genCumm(size_t N, const char* gen, MyUINT2* cumm, vector<MyUINT1> &skippedList);
 
-    template<typename MyUINT2>
-    void genCummMultithreaded(size_t N, const char* gen, uint8_t* counts, MyUINT2* cumm);
-
     void dumpMEM(SequenceItem& item1, SequenceItem& item2, size_t* match);
     void dumpMEMTight(SequenceItem& item1, size_t* match, size_t counter);
 
@@ -65,6 +65,21 @@ private:
     template <class MyUINT1, class MyUINT2>
     void deleteHashBuffer(HashBuffer<MyUINT1, MyUINT2> & buf);
 
+    // state of exact matches query scan after a batch of positions
+    struct ExactMatchScanState {
+        size_t matchesCount;
+        std::uint32_t l2, r2;
+    };
+
+    template<typename MyUINT1, typename MyUINT2>
+    size_t scanExactMatchesTight(HashBuffer<MyUINT1, MyUINT2> buffer, vector<TextMatch> &resMatches,
+                                 const string &destText, bool destIsSrc, bool revComplMatching,
+                                 uint32_t minMatchLength, size_t firstBatch, size_t lastBatch, bool withEndPart,
+                                 ExactMatchScanState &state, vector<ExactMatchScanState> *batchStates);
+
+    bool isEquivalentScanState(const vector<TextMatch> &lMatches, const ExactMatchScanState &lState,
+                               const vector<TextMatch> &rMatches, const ExactMatchScanState &rState, size_t pos);
+
     template<typename MyUINT1, typename MyUINT2>
     void processExactMatchQueryTight(HashBuffer<MyUINT1, MyUINT2> buffer, vector<TextMatch> &resMatches,
                                      const string &destText,
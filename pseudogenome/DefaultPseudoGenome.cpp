@@ -285,9 +285,17 @@ namespace PgSAIndex {
     template class DefaultPseudoGenome<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max>::Type>;
     template class DefaultPseudoGenome<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_std, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_std>::Type>;
     template class DefaultPseudoGenome<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max>::Type>;
+    template class DefaultPseudoGenome<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std>::Type>;
+    template class DefaultPseudoGenome<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max>::Type>;
+    template class DefaultPseudoGenome<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std>::Type>;
+    template class DefaultPseudoGenome<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max>::Type>;
     
     template class GeneratedPseudoGenome<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_std, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_std>::Type>;
     template class GeneratedPseudoGenome<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max>::Type>;
     template class GeneratedPseudoGenome<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_std, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_std>::Type>;
     template class GeneratedPseudoGenome<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max>::Type>;
+    template class GeneratedPseudoGenome<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std>::Type>;
+    template class GeneratedPseudoGenome<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max>::Type>;
+    template class GeneratedPseudoGenome<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std>::Type>;
+    template class GeneratedPseudoGenome<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max, typename ListOfConstantLengthReadsTypeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max>::Type>;
 }
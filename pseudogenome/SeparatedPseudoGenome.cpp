@@ -38,15 +38,17 @@ namespace PgTools {
     }
 
     void SeparatedPseudoGenome::applyIndexesMapping(IndexesMapping *indexesMapping) {
-        for(uint_reads_cnt_std& idx: readsList->orgIdx)
-            idx = indexesMapping->getReadOriginalIndex(idx);
+        ReadsIndexesVector &orgIdx = readsList->orgIdx;
+        orgIdx.fitReadsCount(indexesMapping->getReadsTotalCount());
+        for(uint_reads_cnt_max i = 0; i < orgIdx.size(); i++)
+            orgIdx.set(i, indexesMapping->getReadOriginalIndex(orgIdx[i]));
     }
 
     void SeparatedPseudoGenome::applyRevComplPairFile() {
-        uint_reads_cnt_std readsCount = readsList->orgIdx.size();
+        uint_reads_cnt_max readsCount = readsList->orgIdx.size();
         if (!readsList->isRevCompEnabled())
             readsList->revComp.resize(readsCount, false);
-        for(uint_reads_cnt_std i = 0; i < readsCount; i++)
+        for(uint_reads_cnt_max i = 0; i < readsCount; i++)
             if (readsList->orgIdx[i] % 2)
                 readsList->revComp[i] = !readsList->revComp[i];
     }
@@ -76,7 +78,7 @@ namespace PgTools {
         if (this->readsList->revComp[idx])
             PgSAHelpers::reverseComplementInPlace(ptr, this->readsList->readLength);
         for(uint8_t i = 0; i < this->readsList->getMisCount(idx); i++) {
-            const uint8_t misPos = this->readsList->getMisOff(idx, i);
+            const uint_read_len_max misPos = this->readsList->getMisOff(idx, i);
             ptr[misPos] = PgSAHelpers::code2mismatch(ptr[misPos],
                                                this->readsList->getMisSymCode(idx, i));
         }
@@ -88,7 +90,7 @@ namespace PgTools {
             PgSAHelpers::reverseComplementInPlace(ptr, this->readsList->readLength);
         if (this->readsList->areMismatchesEnabled()) {
             for (uint8_t i = 0; i < this->readsList->getMisCount(idx); i++) {
-                const uint8_t misPos = this->readsList->getMisOff(idx, i);
+                const uint_read_len_max misPos = this->readsList->getMisOff(idx, i);
                 ptr[misPos] = PgSAHelpers::code2mismatch(ptr[misPos],
                                                          this->readsList->getMisSymCode(idx, i));
             }
@@ -101,7 +103,7 @@ namespace PgTools {
             PgSAHelpers::reverseComplementInPlace(ptr, this->readsList->readLength);
         uint8_t mismatchesCount = this->readsList->misCnt[nextRlIdx];
         for (uint8_t i = 0; i < mismatchesCount; i++) {
-            const uint8_t misPos = this->readsList->misOff[curMisCumCount];
+            const uint_read_len_max misPos = this->readsList->misOff[curMisCumCount];
             ptr[misPos] = PgSAHelpers::code2mismatch(ptr[misPos],
                                                      this->readsList->misSymCode[curMisCumCount++]);
         }
@@ -124,6 +126,7 @@ namespace PgTools {
         pgSequence.resize(sequenceLength);
         sequence = (char_pg*) pgSequence.data();
         readsList->off.reserve(properties->readsCount);
+        readsList->orgIdx.fitReadsCount(properties->readsCount);
         readsList->orgIdx.reserve(properties->readsCount);
     }
 
@@ -144,6 +147,14 @@ namespace PgTools {
         }
     }
 
+    void GeneratedSeparatedPseudoGenome::prepareReadsListSlots(uint_reads_cnt_max readsCount) {
+        if (!isReadLengthMin())
+            readsList->off.useWideValues();
+        readsList->orgIdx.fitReadsCount(readsCount);
+        readsList->off.resize(readsCount);
+        readsList->orgIdx.resize(readsCount);
+    }
+
     void GeneratedSeparatedPseudoGenome::validate() {
     }
 
@@ -5,6 +5,8 @@
 
 #include "SeparatedPseudoGenomeBase.h"
 
+#include <cassert>
+
 namespace PgTools {
 
     const string PGTYPE_SEPARATED = "SEPARATED_PGEN";
@@ -77,6 +79,15 @@ namespace PgTools {
         void append(const string& read, uint_read_len_max length, uint_read_len_max overlap, uint_reads_cnt_max orgIdx);
         void append(uint_read_len_max length, uint_read_len_max overlap, uint_reads_cnt_max orgIdx);
 
+        // alternative to append for filling reads list in parallel (offset is the delta from the previous read);
+        // slots have their widths fixed in advance, so concurrent setReadSlot calls never reallocate
+        void prepareReadsListSlots(uint_reads_cnt_max readsCount);
+        inline void setReadSlot(uint_reads_cnt_max slot, uint_read_len_max offset, uint_reads_cnt_max orgIdx) {
+            assert(readsList->off.holdsWithoutWidening(offset) && readsList->orgIdx.holdsWithoutWidening(orgIdx));
+            readsList->off.set(slot, offset);
+            readsList->orgIdx.set(slot, orgIdx);
+        }
+
         void validate();
     };
 
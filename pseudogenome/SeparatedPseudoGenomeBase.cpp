@@ -52,4 +52,26 @@ namespace PgTools {
         pgPropSrc.close();
     }
 
-}
\ No newline at end of file
+    uchar SeparatedPseudoGenomeBase::getOriginalIndexBytes(istream &rlOrgIdxSrc, uint_reads_cnt_max readsCount) {
+        const streampos curPos = rlOrgIdxSrc.tellg();
+        rlOrgIdxSrc.seekg(0, ios_base::end);
+        const uint64_t srcSize = rlOrgIdxSrc.tellg();
+        rlOrgIdxSrc.seekg(curPos);
+        return readsCount && srcSize == readsCount * sizeof(uint_reads_cnt_max) ?
+               sizeof(uint_reads_cnt_max) : sizeof(uint_reads_cnt_std);
+    }
+
+    uint_reads_cnt_max SeparatedPseudoGenomeBase::readOriginalIndex(istream &rlOrgIdxSrc, uchar orgIdxBytes,
+                                                                   bool plainTextReadMode) {
+        uint_reads_cnt_max idx = 0;
+        if (plainTextReadMode || orgIdxBytes == sizeof(uint_reads_cnt_max))
+            PgSAHelpers::readValue<uint_reads_cnt_max>(rlOrgIdxSrc, idx, plainTextReadMode);
+        else {
+            uint_reads_cnt_std stdIdx = 0;
+            PgSAHelpers::readValue<uint_reads_cnt_std>(rlOrgIdxSrc, stdIdx, false);
+            idx = stdIdx;
+        }
+        return idx;
+    }
+
+}
@@ -41,6 +41,10 @@ namespace PgTools {
         static void getPseudoGenomeProperties(const string &pseudoGenomePrefix, PseudoGenomeHeader *&pgh,
                                               ReadsSetProperties *&rsProp, bool &plainTextReadMode);
 
+        // original indexes are stored as uint_reads_cnt_std unless any of them requires uint_reads_cnt_max
+        static uchar getOriginalIndexBytes(istream &rlOrgIdxSrc, uint_reads_cnt_max readsCount);
+        static uint_reads_cnt_max readOriginalIndex(istream &rlOrgIdxSrc, uchar orgIdxBytes, bool plainTextReadMode);
+
     };
 }
 
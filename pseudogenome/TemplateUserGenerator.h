@@ -38,6 +38,14 @@ namespace PgSAIndex {
                     return PgSAIndex::TemplateUserGenerator::generatePseudoGenomeUserTemplate<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max,
                             PseudoGenomeUserClass, PseudoGenomeUserBase>(pgb);
             }
+            if (pgb->isReadsCountMax()) {
+                if (pgb->isPGLengthStd())
+                    return PgSAIndex::TemplateUserGenerator::generatePseudoGenomeUserTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std,
+                            PseudoGenomeUserClass, PseudoGenomeUserBase>(pgb);
+                if (pgb->isPGLengthMax())
+                    return PgSAIndex::TemplateUserGenerator::generatePseudoGenomeUserTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max,
+                            PseudoGenomeUserClass, PseudoGenomeUserBase>(pgb);
+            }
         }
         if (pgb->isReadLengthStd()) {
             if (pgb->isReadsCountStd()) {
@@ -48,6 +56,14 @@ namespace PgSAIndex {
                     return PgSAIndex::TemplateUserGenerator::generatePseudoGenomeUserTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max,
                             PseudoGenomeUserClass, PseudoGenomeUserBase>(pgb);
             }
+            if (pgb->isReadsCountMax()) {
+                if (pgb->isPGLengthStd())
+                    return PgSAIndex::TemplateUserGenerator::generatePseudoGenomeUserTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std,
+                            PseudoGenomeUserClass, PseudoGenomeUserBase>(pgb);
+                if (pgb->isPGLengthMax())
+                    return PgSAIndex::TemplateUserGenerator::generatePseudoGenomeUserTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max,
+                            PseudoGenomeUserClass, PseudoGenomeUserBase>(pgb);
+            }
         }
 
         cout << "ERROR: CANNOT DETERMINE TEMPLATE TYPES";
@@ -87,6 +103,14 @@ namespace PgSAIndex {
                     return PgSAIndex::TemplateUserGenerator::generateReadsListUserTemplate<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max,
                             ReadsListUserClass, ReadsListUserBase>(pgb);
             }
+            if (pgb->isReadsCountMax()) {
+                if (pgb->isPGLengthStd())
+                    return PgSAIndex::TemplateUserGenerator::generateReadsListUserTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std,
+                            ReadsListUserClass, ReadsListUserBase>(pgb);
+                if (pgb->isPGLengthMax())
+                    return PgSAIndex::TemplateUserGenerator::generateReadsListUserTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max,
+                            ReadsListUserClass, ReadsListUserBase>(pgb);
+            }
         }
         if (pgb->isReadLengthStd()) {
             if (pgb->isReadsCountStd()) {
@@ -97,6 +121,14 @@ namespace PgSAIndex {
                     return PgSAIndex::TemplateUserGenerator::generateReadsListUserTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max,
                             ReadsListUserClass, ReadsListUserBase>(pgb);
             }
+            if (pgb->isReadsCountMax()) {
+                if (pgb->isPGLengthStd())
+                    return PgSAIndex::TemplateUserGenerator::generateReadsListUserTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std,
+                            ReadsListUserClass, ReadsListUserBase>(pgb);
+                if (pgb->isPGLengthMax())
+                    return PgSAIndex::TemplateUserGenerator::generateReadsListUserTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max,
+                            ReadsListUserClass, ReadsListUserBase>(pgb);
+            }
         }
 
         cout << "ERROR: CANNOT DETERMINE TEMPLATE TYPES";
@@ -2,40 +2,74 @@
 #include <cassert>
 #include "AbstractOverlapPseudoGenomeGenerator.h"
 
+// reads having predecessors but not reachable from heads of chains belong to cycles
 template<typename uint_read_len, typename uint_reads_cnt>
 void AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len, uint_reads_cnt>::removeCyclesAndPrepareComponents() {
-    this->headRead = (uint_reads_cnt *) calloc(this->readsTotal() + 1, sizeof(uint_reads_cnt));
+    const uint_reads_cnt readsCount = this->readsTotal();
+    predecessorBits.allocate(readsCount + 1);
+#pragma omp parallel for
+    for(uint_reads_cnt curIdx = 1; curIdx <= readsCount; curIdx++)
+        if (this->nextRead[curIdx])
+            predecessorBits.set(this->nextRead[curIdx]);
+    RankedBitVector cycleBits;
+    cycleBits.assign(predecessorBits);
+#pragma omp parallel for schedule(guided)
+    for(uint_reads_cnt curIdx = 1; curIdx <= readsCount; curIdx++)
+        if (!predecessorBits[curIdx]) {
+            uint_reads_cnt nextIdx = curIdx;
+            while ((nextIdx = this->nextRead[nextIdx]))
+                cycleBits.reset(nextIdx);
+        }
+    cycleBits.buildRank();
+
+    vector<vector<uint_reads_cnt>> threadCycleReads(numberOfThreads);
+#pragma omp parallel for
+    for(uint8_t t = 0; t < numberOfThreads; t++) {
+        const uint_reads_cnt endIdx = 1 + (uint_reads_cnt_max) readsCount * (t + 1) / numberOfThreads;
+        for(uint_reads_cnt curIdx = 1 + (uint_reads_cnt_max) readsCount * t / numberOfThreads; curIdx < endIdx; curIdx++)
+            if (cycleBits[curIdx])
+                threadCycleReads[t].push_back(curIdx);
+    }
+    vector<uint_reads_cnt> cycleReads;
+    cycleReads.reserve(cycleBits.count());
+    for(uint8_t t = 0; t < numberOfThreads; t++)
+        cycleReads.insert(cycleReads.end(), threadCycleReads[t].begin(), threadCycleReads[t].end());
+    vector<vector<uint_reads_cnt>>().swap(threadCycleReads);
+
+    // each cycle is broken after its highest index read (found by pointer jumping)
+    const uint_reads_cnt cycleReadsCount = cycleReads.size();
+    vector<uint_reads_cnt> jump(cycleReadsCount), nextJump(cycleReadsCount);
+    vector<uint_reads_cnt> maxIdx(cycleReads), nextMaxIdx(cycleReadsCount);
+#pragma omp parallel for
+    for(uint_reads_cnt p = 0; p < cycleReadsCount; p++)
+        jump[p] = cycleBits.rank(this->nextRead[cycleReads[p]]);
+    bool maxIdxChanged = cycleReadsCount > 0;
+    while (maxIdxChanged) {
+        maxIdxChanged = false;
+#pragma omp parallel for reduction(||:maxIdxChanged)
+        for(uint_reads_cnt p = 0; p < cycleReadsCount; p++) {
+            nextMaxIdx[p] = maxIdx[jump[p]] > maxIdx[p] ? maxIdx[jump[p]] : maxIdx[p];
+            nextJump[p] = jump[jump[p]];
+            if (nextMaxIdx[p] != maxIdx[p])
+                maxIdxChanged = true;
+        }
+        maxIdx.swap(nextMaxIdx);
+        jump.swap(nextJump);
+    }
+
     uint_reads_cnt cyclesCount = 0;
     uint_reads_cnt overlapLost = 0;
-    uint_reads_cnt nextIdx;
-    for(uint_reads_cnt curIdx = 1; curIdx <= this->readsTotal(); curIdx++) {
-        if (nextIdx = this->nextRead[curIdx]) {
-            if (this->isHeadOf(curIdx, nextIdx)) {
-                cyclesCount++;
-                uint_read_len minOverlap = this->overlap[curIdx];
-                uint_reads_cnt minOverlapIdx = curIdx;
-                nextIdx = curIdx;
-                while ((nextIdx = this->nextRead[nextIdx]) != curIdx) {
-                    if (minOverlap > this->overlap[nextIdx]) {
-                        uint_read_len minOverlap = this->overlap[nextIdx];
-                        uint_reads_cnt minOverlapIdx = nextIdx;
-                    }
-                }
-                overlapLost += minOverlap;
-                uint_reads_cnt headIdx = this->nextRead[minOverlapIdx];
-                this->nextRead[minOverlapIdx] = 0;
-                this->overlap[minOverlapIdx] = 0;
-                nextIdx = headIdx;
-                this->headRead[headIdx] = 0;
-                while ((nextIdx = this->nextRead[nextIdx]))
-                    this->headRead[nextIdx] = headIdx;
-            } else {
-                if (this->headRead[curIdx] == 0)
-                    this->headRead[nextIdx] = curIdx;
-                else
-                    this->headRead[nextIdx] = this->headRead[curIdx];
-            }
-        }
+#pragma omp parallel for reduction(+:cyclesCount) reduction(+:overlapLost)
+    for(uint_reads_cnt p = 0; p < cycleReadsCount; p++) {
+        const uint_reads_cnt curIdx = cycleReads[p];
+        if (maxIdx[p] != curIdx)
+            continue;
+        cyclesCount++;
+        overlapLost += this->overlap[curIdx];
+        uint_reads_cnt headIdx = this->nextRead[curIdx];
+        this->nextRead[curIdx] = 0;
+        this->overlap[curIdx] = 0;
+        predecessorBits.reset(headIdx);
     }
     *logout << "Removed " << cyclesCount << " cycles (lost " << overlapLost << " symbols)" << endl;
 }
@@ -49,18 +83,22 @@ namespace PgSAIndex {
 
     template<typename uint_read_len, typename uint_reads_cnt>
     void AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len, uint_reads_cnt>::init(bool pgGenerationMode) {
-        nextRead = (uint_reads_cnt*) calloc(readsTotal() + 1, sizeof(uint_reads_cnt));
-        overlap = (uint_read_len *) calloc(readsTotal() + 1, sizeof(uint_read_len));
+        nextRead = (uint_reads_cnt*) allocateLargeArray((readsTotal() + 1) * sizeof(uint_reads_cnt));
+        overlap = (uint_read_len *) allocateLargeArray((readsTotal() + 1) * sizeof(uint_read_len));
         if (isGenerationCyclesAware(pgGenerationMode))
-            headRead = (uint_reads_cnt *) calloc(readsTotal() + 1, sizeof(uint_reads_cnt));
+            headRead = (uint_reads_cnt *) allocateLargeArray((readsTotal() + 1) * sizeof(uint_reads_cnt));
         readsLeft = readsTotal();
     }
     
     template<typename uint_read_len, typename uint_reads_cnt>
     void AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len, uint_reads_cnt>::dispose() {   
-        free(nextRead);
-        free(overlap);
-        free(headRead);
+        freeLargeArray(nextRead, (readsTotal() + 1) * sizeof(uint_reads_cnt));
+        freeLargeArray(overlap, (readsTotal() + 1) * sizeof(uint_read_len));
+        freeLargeArray(headRead, (readsTotal() + 1) * sizeof(uint_reads_cnt));
+        nextRead = 0;
+        overlap = 0;
+        headRead = 0;
+        predecessorBits.clear();
     }
 
 
@@ -178,6 +216,75 @@ namespace PgSAIndex {
         *logout << countSingles() << " single reads\n";
     }
 
+    template<typename uint_read_len, typename uint_reads_cnt>
+    GeneratedSeparatedPseudoGenome* AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len, uint_reads_cnt>::assembleSeparatedPseudoGenome() {
+        time_checkpoint();
+        if (!getReadsSetProperties()->constantReadLength) {
+            cout << "ERROR: Unsuported variable reads length!";
+            exit(EXIT_FAILURE);
+        }
+
+        GeneratedSeparatedPseudoGenome* genPG =
+                new GeneratedSeparatedPseudoGenome(this->pseudoGenomeLength, getReadsSetProperties());
+        const uint_reads_cnt readsCount = readsTotal();
+        const uint_read_len readLength = this->getReadsSetProperties()->maxReadLength;
+        genPG->prepareReadsListSlots(readsCount);
+
+        // components are assembled per ranges of head indexes at offsets given by prefix sums of ranges' lengths
+        const uint_reads_cnt_max rangesCount = (uint_reads_cnt_max) numberOfThreads * ASSEMBLY_RANGES_PER_THREAD;
+        vector<uint_reads_cnt_max> rangeReadsPos(rangesCount + 1, 0);
+        vector<uint_pg_len_max> rangeSequencePos(rangesCount + 1, 0);
+#pragma omp parallel for schedule(dynamic)
+        for (uint_reads_cnt_max r = 0; r < rangesCount; r++) {
+            const uint_reads_cnt endIdx = 1 + readsCount * (r + 1) / rangesCount;
+            for (uint_reads_cnt i = 1 + readsCount * r / rangesCount; i < endIdx; i++) {
+                uint_reads_cnt idx = i;
+                if (!hasPredecessor(idx))
+                    do {
+                        rangeReadsPos[r + 1]++;
+                        rangeSequencePos[r + 1] += readLength - overlap[idx];
+                        idx = nextRead[idx];
+                    } while (idx != 0);
+            }
+        }
+        for (uint_reads_cnt_max r = 0; r < rangesCount; r++) {
+            rangeReadsPos[r + 1] += rangeReadsPos[r];
+            rangeSequencePos[r + 1] += rangeSequencePos[r];
+        }
+
+#pragma omp parallel for schedule(dynamic)
+        for (uint_reads_cnt_max r = 0; r < rangesCount; r++) {
+            char* seq = genPG->getSequencePtr() + rangeSequencePos[r];
+            uint_reads_cnt_max slot = rangeReadsPos[r];
+            uint_read_len_max offset = slot ? readLength : 0;
+            uint_read_len prefixDoneLength = 0;
+            const uint_reads_cnt endIdx = 1 + readsCount * (r + 1) / rangesCount;
+            for (uint_reads_cnt i = 1 + readsCount * r / rangesCount; i < endIdx; i++) {
+                uint_reads_cnt idx = i;
+                if (!hasPredecessor(idx))
+                    do {
+                        genPG->setReadSlot(slot++, offset, idx - 1);
+                        const uint_read_len shiftLength = readLength - overlap[idx];
+                        offset = shiftLength;
+                        if (prefixDoneLength < shiftLength) {
+                            getReadSuffix(seq, idx, prefixDoneLength);
+                            seq += readLength - prefixDoneLength;
+                            prefixDoneLength = overlap[idx];
+                        } else {
+                            prefixDoneLength -= shiftLength;
+                        }
+                        idx = nextRead[idx];
+
+                    } while (idx != 0);
+            }
+        }
+
+        genPG->validate();
+        *logout << "Pseudogenome assembled in " << time_millis() << " msec\n\n";
+
+        return genPG;
+    }
+
     template<typename uint_read_len, typename uint_reads_cnt>
     template<class GeneratedPseudoGenome>
     GeneratedPseudoGenome* AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len, uint_reads_cnt>::assemblePseudoGenomeTemplate() {
@@ -220,8 +327,7 @@ namespace PgSAIndex {
 
     template<typename uint_read_len, typename uint_reads_cnt>
     bool AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len, uint_reads_cnt>::hasPredecessor(uint_reads_cnt incIdx) {
-        assert(headRead != 0);
-        return headRead[incIdx];
+        return predecessorBits[incIdx];
     }
 
     template<typename uint_read_len, typename uint_reads_cnt>
@@ -250,7 +356,7 @@ namespace PgSAIndex {
         init();
         performOverlapping();
 
-        SeparatedPseudoGenome* pg = assemblePseudoGenomeTemplate<GeneratedSeparatedPseudoGenome>();
+        SeparatedPseudoGenome* pg = assembleSeparatedPseudoGenome();
 
         dispose();
         return pg;
@@ -278,5 +384,7 @@ namespace PgSAIndex {
 
     template class AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len_min, uint_reads_cnt_std>;
     template class AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len_std, uint_reads_cnt_std>;
+    template class AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len_min, uint_reads_cnt_max>;
+    template class AbstractOverlapPseudoGenomeGeneratorTemplate<uint_read_len_std, uint_reads_cnt_max>;
     
 }
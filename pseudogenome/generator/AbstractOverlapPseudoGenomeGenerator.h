@@ -5,6 +5,9 @@
 #include <algorithm>
 #include <set>
 #include "../persistence/SeparatedPseudoGenomePersistence.h"
+#include "../../utils/RankedBitVector.h"
+
+#define ASSEMBLY_RANGES_PER_THREAD 16
 
 using namespace PgSAReadsSet;
 
@@ -19,7 +22,10 @@ namespace PgSAIndex {
         // auxiliary structures
         uint_reads_cnt* nextRead = 0;
         uint_read_len* overlap = 0;
+        // chain heads of cycle-aware generation (allocated only in that mode)
         uint_reads_cnt* headRead = 0;
+        // reads having predecessors (set when cycles are removed)
+        RankedBitVector predecessorBits;
         uint_reads_cnt readsLeft;
 
         bool hasPredecessor(uint_reads_cnt incIdx);
@@ -43,6 +49,7 @@ namespace PgSAIndex {
 
         template<class GeneratedPseudoGenome>
         GeneratedPseudoGenome* assemblePseudoGenomeTemplate();
+        GeneratedSeparatedPseudoGenome* assembleSeparatedPseudoGenome();
 
         virtual void findOverlappingReads(double overlappedReadsCountStopCoef, bool pgGenerationMode) = 0;
 
@@ -253,6 +253,8 @@ namespace PgSAIndex {
 
         if (isReadsCountStd(readsSet->readsCount()))
             return getGeneratorFullTemplate<uint_read_len, uint_reads_cnt_std>(readsSet, ownReadsSet);
+        else if (isReadsCountMax(readsSet->readsCount()))
+            return getGeneratorFullTemplate<uint_read_len, uint_reads_cnt_max>(readsSet, ownReadsSet);
         else
             cout << "UNSUPPORTED READS COUNT!!!???";
 
@@ -41,6 +41,13 @@ namespace PgSAIndex {
                             if (pgb->isPGLengthMax())
                                 return generatePseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max>();
                         }
+                        if (pgb->isReadsCountMax()) {
+                            if (pgb->isPGLengthStd()) {
+                                return generatePseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std>();
+                            }
+                            if (pgb->isPGLengthMax())
+                                return generatePseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max>();
+                        }
                     }
                     if (pgb->isReadLengthStd()) {
                         if (pgb->isReadsCountStd()) {
@@ -49,6 +56,12 @@ namespace PgSAIndex {
                             if (pgb->isPGLengthMax())
                                 return generatePseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max>();
                         }                            
+                        if (pgb->isReadsCountMax()) {
+                            if (pgb->isPGLengthStd())
+                                return generatePseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std>();
+                            if (pgb->isPGLengthMax())
+                                return generatePseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max>();
+                        }
                     }
                 }
                 cout << "ERROR: wrong source PGSATYPE " << pgb->getTypeID();
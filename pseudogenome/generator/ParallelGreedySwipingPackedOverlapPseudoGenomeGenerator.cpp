@@ -2,7 +2,6 @@
 #include "../../readsset/persistance/ReadsSetPersistence.h"
 #include "AbstractOverlapPseudoGenomeGenerator.h"
 
-#include <parallel/algorithm>
 #include <cassert>
 
 using namespace PgSAReadsSet;
@@ -65,32 +64,36 @@ namespace PgSAIndex {
     }
 
     template<typename uint_read_len, typename uint_reads_cnt>
-    int ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::compareSuffixes(
-            uchar lSymOrder, uchar rSymOrder, uint_read_len offset, uint_reads_cnt* ssiSymbolIdx) {
-        uint_reads_cnt lIncIdx = sortedSuffixIdxsPtr[ssiSymbolIdx[lSymOrder]];
-        uint_reads_cnt rIncIdx = sortedSuffixIdxsPtr[ssiSymbolIdx[rSymOrder]];
-        return packedReadsSet->comparePackedReads(lIncIdx - 1, rIncIdx - 1, offset);
+    int ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::compareSuffixWithPrefix(uint_reads_cnt sufIncIdx, uint_reads_cnt preIncIdx, uint_read_len sufOffset) {
+        return packedReadsSet->compareSuffixWithPrefix(sufIncIdx - 1, preIncIdx - 1, sufOffset);
     }
 
     template<typename uint_read_len, typename uint_reads_cnt>
-    int ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::compareSuffixWithPrefix(uint_reads_cnt sufIncIdx, uint_reads_cnt preIncIdx, uint_read_len sufOffset) {
-        return packedReadsSet->compareSuffixWithPrefix(sufIncIdx - 1, preIncIdx - 1, sufOffset);
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::updateSuffixGroupHead(
+            SuffixGroupHead &head, uint_read_len suffixOffset, uint_reads_cnt &turn) {
+        while (head.pos < head.end && this->nextRead[sortedSuffixIdxsPtr[head.pos]] != 0)
+            head.pos++;
+        if (head.pos < head.end) {
+            head.key = packedReadsSet->sPacker->getSequenceKey(
+                    packedReadsSet->getPackedRead(sortedSuffixIdxsPtr[head.pos] - 1), suffixOffset,
+                    packedReadsSet->maxReadLength() - suffixOffset);
+            head.turn = turn++;
+        }
     }
 
     template<typename uint_read_len, typename uint_reads_cnt>
-    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::updateSuffixQueue(
-            uchar suffixGroup, uint_read_len suffixOffset,
-            uint_reads_cnt* ssiSymbolIdx, uint_reads_cnt* ssiSymbolEnd, deque<uchar> &ssiOrder) {
-        if (ssiSymbolIdx[suffixGroup] < ssiSymbolEnd[suffixGroup]) {
-            deque<uchar>::reverse_iterator it = ssiOrder.rbegin();
-            while (true) {
-                if (it == ssiOrder.rend() || compareSuffixes(suffixGroup, *it, suffixOffset, ssiSymbolIdx) >= 0) {
-                    ssiOrder.insert(it.base(), suffixGroup);
-                    break;
-                }
-                it++;
-            }
+    bool ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::isSuffixGroupHeadFirst(
+            const SuffixGroupHead &l, const SuffixGroupHead &r, uint_read_len suffixOffset) {
+        if (l.key != r.key)
+            return l.key < r.key;
+        const uint_read_len_max keyedLength = suffixOffset + packedReadsSet->sPacker->getKeySymbolsCount();
+        if (keyedLength < packedReadsSet->maxReadLength()) {
+            int cmpRes = packedReadsSet->comparePackedReads(sortedSuffixIdxsPtr[l.pos] - 1,
+                    sortedSuffixIdxsPtr[r.pos] - 1, keyedLength);
+            if (cmpRes)
+                return cmpRes < 0;
         }
+        return l.turn < r.turn;
     }
 
     template<typename uint_read_len, typename uint_reads_cnt>
@@ -109,17 +112,95 @@ namespace PgSAIndex {
 
 
     template<typename uint_read_len, typename uint_reads_cnt>
-    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::prepareSortedReadsBlocks() {
-        for (uint_reads_cnt i = 1; i <= packedReadsSet->readsCount(); i++)
-            sortedReadsIdxs.push_back(i);
-        PackedReadsComparator comparePacked = PackedReadsComparator(this);
-        __gnu_parallel::sort(sortedReadsIdxs.begin(), sortedReadsIdxs.end(), comparePacked);
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::radixSortOfReadsIdxs(
+            uint_reads_cnt *idxs, uint_reads_cnt *tmpIdxs, uint_reads_cnt count, uint_read_len_max bytePos) {
+        const uint_read_len_max packedLength = packedReadsSet->getPackedLength();
+        if (count < 2 || bytePos == packedLength)
+            return;
+        if (count <= RADIX_SORT_INSERTION_SORT_THRESHOLD) {
+            for (uint_reads_cnt i = 1; i < count; i++) {
+                const uint_reads_cnt incIdx = idxs[i];
+                const uint_ps_element_min *read = packedReadsSet->getPackedRead(incIdx - 1) + bytePos;
+                uint_reads_cnt j = i;
+                for (; j > 0; j--) {
+                    if (memcmp(packedReadsSet->getPackedRead(idxs[j - 1] - 1) + bytePos, read,
+                            packedLength - bytePos) <= 0)
+                        break;
+                    idxs[j] = idxs[j - 1];
+                }
+                idxs[j] = incIdx;
+            }
+            return;
+        }
+        uint_reads_cnt bucketPos[UINT8_MAX + 1] = { 0 };
+        for (uint_reads_cnt i = 0; i < count; i++)
+            bucketPos[packedReadsSet->getPackedRead(idxs[i] - 1)[bytePos]]++;
+        uint_reads_cnt pos = 0;
+        for (uint16_t b = 0; b <= UINT8_MAX; b++) {
+            uint_reads_cnt bucketCount = bucketPos[b];
+            bucketPos[b] = pos;
+            pos += bucketCount;
+        }
+        for (uint_reads_cnt i = 0; i < count; i++)
+            tmpIdxs[bucketPos[packedReadsSet->getPackedRead(idxs[i] - 1)[bytePos]]++] = idxs[i];
+        memcpy(idxs, tmpIdxs, count * sizeof(uint_reads_cnt));
+        // after scattering bucketPos[b] points at the end of bucket b
+        uint_reads_cnt bucketStart = 0;
+        for (uint16_t b = 0; b <= UINT8_MAX; b++) {
+            radixSortOfReadsIdxs(idxs + bucketStart, tmpIdxs + bucketStart, bucketPos[b] - bucketStart, bytePos + 1);
+            bucketStart = bucketPos[b];
+        }
+    }
+
+    // stable MSD radix sort on packed read bytes (lexicographic order of packed reads)
+    template<typename uint_read_len, typename uint_reads_cnt>
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::parallelRadixSortOfReadsIdxs(
+            const vector<uint_reads_cnt> &uniqueReadsIdxs) {
+        const uint_reads_cnt readsCount = uniqueReadsIdxs.size();
+        sortedReadsIdxs.allocate(readsCount, spillIndexes);
+        SpillableArray<uint_reads_cnt> tmpIdxs;
+        tmpIdxs.allocate(readsCount, spillIndexes);
+        vector<uint_reads_cnt> threadBucketPos((size_t) numberOfThreads * (UINT8_MAX + 1), 0);
+        #pragma omp parallel for
+        for (int t = 0; t < numberOfThreads; t++) {
+            uint_reads_cnt *bucketCount = threadBucketPos.data() + (size_t) t * (UINT8_MAX + 1);
+            const uint_reads_cnt end = (uint64_t) readsCount * (t + 1) / numberOfThreads;
+            for (uint_reads_cnt i = (uint64_t) readsCount * t / numberOfThreads; i < end; i++)
+                bucketCount[packedReadsSet->getPackedRead(uniqueReadsIdxs[i] - 1)[0]]++;
+        }
+        uint_reads_cnt bucketPos[UINT8_MAX + 2];
+        uint_reads_cnt pos = 0;
+        for (uint16_t b = 0; b <= UINT8_MAX; b++) {
+            bucketPos[b] = pos;
+            for (int t = 0; t < numberOfThreads; t++) {
+                uint_reads_cnt &threadPos = threadBucketPos[(size_t) t * (UINT8_MAX + 1) + b];
+                uint_reads_cnt bucketCount = threadPos;
+                threadPos = pos;
+                pos += bucketCount;
+            }
+        }
+        bucketPos[UINT8_MAX + 1] = pos;
+        #pragma omp parallel for
+        for (int t = 0; t < numberOfThreads; t++) {
+            uint_reads_cnt *threadPos = threadBucketPos.data() + (size_t) t * (UINT8_MAX + 1);
+            const uint_reads_cnt end = (uint64_t) readsCount * (t + 1) / numberOfThreads;
+            for (uint_reads_cnt i = (uint64_t) readsCount * t / numberOfThreads; i < end; i++)
+                sortedReadsIdxs[threadPos[packedReadsSet->getPackedRead(uniqueReadsIdxs[i] - 1)[0]]++] = uniqueReadsIdxs[i];
+        }
+        #pragma omp parallel for schedule(dynamic)
+        for (uint16_t b = 0; b <= UINT8_MAX; b++)
+            radixSortOfReadsIdxs(sortedReadsIdxs.data() + bucketPos[b], tmpIdxs.data() + bucketPos[b],
+                    bucketPos[b + 1] - bucketPos[b], 1);
+    }
 
+    template<typename uint_read_len, typename uint_reads_cnt>
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::findSortedReadsBlocksPositions() {
         blocksCount = pow(symbolsCount, blockPrefixLength);
+        sortedReadsBlockPos.resize(blocksCount + 1);
         #pragma omp parallel for
-        for (uint16_t b = 0; b < blocksCount; b++) {
-            char *prefix = blockPrefixes[b];
-            uint16_t val = b;
+        for (uint32_t b = 0; b < blocksCount; b++) {
+            char prefix[MAX_BLOCK_PREFIX_LENGTH + 1] = { 0 };
+            uint32_t val = b;
             for (uint8_t j = 0; j < blockPrefixLength; j++) {
                 uint8_t div = val % symbolsCount;
                 prefix[blockPrefixLength - j - 1] = packedReadsSet->getReadsSetProperties()->symbolsList[div];
@@ -130,15 +211,228 @@ namespace PgSAIndex {
                                                  comparePackedWithPattern.PATTERN_INDEX,
                                                  comparePackedWithPattern) - sortedReadsIdxs.begin();
         }
-        sortedReadsBlockPos[blocksCount] = packedReadsSet->readsCount();
+        sortedReadsBlockPos[blocksCount] = sortedReadsIdxs.size();
+    }
+
+    template<typename uint_read_len, typename uint_reads_cnt>
+    uint_reads_cnt ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::maxBlockReadsCount() {
+        uint_reads_cnt maxCount = 0;
+        for (uint32_t b = 0; b < blocksCount; b++)
+            if (sortedReadsBlockPos[b + 1] - sortedReadsBlockPos[b] > maxCount)
+                maxCount = sortedReadsBlockPos[b + 1] - sortedReadsBlockPos[b];
+        return maxCount;
+    }
+
+    template<typename uint_read_len, typename uint_reads_cnt>
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::prepareSortedReadsBlocks(
+            const vector<uint_reads_cnt> &uniqueReadsIdxs) {
+        parallelRadixSortOfReadsIdxs(uniqueReadsIdxs);
+
+        // block prefix is extended while some block is too heavy to be balanced among threads
+        const uint_reads_cnt_max readsCount = sortedReadsIdxs.size();
+        blockPrefixLength = MIN_BLOCK_PREFIX_LENGTH;
+        findSortedReadsBlocksPositions();
+        while (blockPrefixLength < MAX_BLOCK_PREFIX_LENGTH && 2 * (blockPrefixLength + 1) < packedReadsSet->maxReadLength()
+               && (uint_reads_cnt_max) blocksCount * symbolsCount * MIN_AVERAGE_READS_PER_BLOCK <= readsCount
+               && (uint_reads_cnt_max) maxBlockReadsCount() * BLOCK_BALANCE_FACTOR * numberOfThreads > readsCount) {
+            blockPrefixLength++;
+            findSortedReadsBlocksPositions();
+        }
+        *logout << "Block prefix length: " << (int) blockPrefixLength << " (" << blocksCount << " blocks)" << endl;
+
+        sortedReadsCount.assign(blocksCount, 0);
+        sortedSuffixBlockPos.resize(blocksCount + 1);
+        sortedSuffixBlockPlusSymbolPos.resize(blocksCount + 1);
+    }
+
+    // packed reads and links arrays
+    template<typename uint_read_len, typename uint_reads_cnt>
+    uint64_t ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::residentBytes() {
+        const uint_reads_cnt_max readsCount = packedReadsSet->readsCount();
+        return (uint64_t) readsCount * packedReadsSet->getPackedLength()
+                + (uint64_t) (readsCount + 1) * (2 * sizeof(uint_reads_cnt) + sizeof(uint_read_len));
+    }
+
+    template<typename uint_read_len, typename uint_reads_cnt>
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::planIndexesMemory() {
+        if (!maxMemoryUsage)
+            return;
+        const uint64_t residentBytes = this->residentBytes();
+        // sorted reads, sorted suffixes and merged suffixes (of unique reads)
+        const uint64_t indexesBytes = (uint64_t) this->readsLeft * 3 * sizeof(uint_reads_cnt);
+        spillIndexes = residentBytes + indexesBytes > maxMemoryUsage;
+        if (!spillIndexes)
+            return;
+        maxGroupIndexesCount = residentBytes < maxMemoryUsage ?
+                (maxMemoryUsage - residentBytes) / (3 * sizeof(uint_reads_cnt)) : 0;
+        *logout << "Spilling reads indexes to temporary files (" << (residentBytes + indexesBytes) / 1024 / 1024
+                << " MB required; up to " << maxGroupIndexesCount << " indexes in a group of blocks)" << endl;
+    }
+
+    template<typename uint_read_len, typename uint_reads_cnt>
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::findBlocksGroupsEnds(
+            uint32_t curBlocksCount, vector<uint32_t> &groupsEnds) {
+        groupsEnds.clear();
+        uint_reads_cnt_max groupIndexesCount = 0;
+        for (uint32_t b = 0; b < curBlocksCount; b++) {
+            const uint_reads_cnt_max blockIndexesCount = (uint_reads_cnt_max) sortedReadsCount[b] +
+                    sortedSuffixBlockPos[b + 1] - sortedSuffixBlockPos[b];
+            if (groupIndexesCount && groupIndexesCount + blockIndexesCount > maxGroupIndexesCount) {
+                groupsEnds.push_back(b);
+                groupIndexesCount = 0;
+            }
+            groupIndexesCount += blockIndexesCount;
+        }
+        groupsEnds.push_back(curBlocksCount);
+    }
+
+    static inline uint64_t finalizePackedReadHash(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // 128-bit hash of a packed read computed in two independent 64-bit lanes
+    static inline void hashPackedRead(const uint8_t* read, uint_read_len_max packedLength, uint64_t &hashLow, uint64_t &hashHigh) {
+        const uint64_t MUL_LOW = 0x87c37b91114253d5ULL;
+        const uint64_t MUL_HIGH = 0x4cf5ad432745937fULL;
+        uint64_t hLow = packedLength;
+        uint64_t hHigh = ~(uint64_t) packedLength;
+        for (uint_read_len_max i = 0; i < packedLength; i += 8) {
+            uint64_t word = 0;
+            memcpy(&word, read + i, packedLength - i < 8 ? packedLength - i : 8);
+            hLow ^= word * MUL_LOW;
+            hLow = ((hLow << 27) | (hLow >> 37)) * 5 + 0x52dce729;
+            hHigh ^= word * MUL_HIGH;
+            hHigh = ((hHigh << 31) | (hHigh >> 33)) * 5 + 0x38495ab5;
+        }
+        hashLow = finalizePackedReadHash(hLow + hHigh);
+        hashHigh = finalizePackedReadHash(hHigh + hashLow);
+    }
+
+    template<typename uint_read_len, typename uint_reads_cnt>
+    uint_reads_cnt_max ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::findDuplicatesTableSlot(
+            DuplicatesTableSlot* table, uint_reads_cnt_max slotsMask, uint_reads_cnt incIdx, bool insertMode) {
+        const uint_read_len_max packedLength = packedReadsSet->getPackedLength();
+        const uint8_t* read = packedReadsSet->getPackedRead(incIdx - 1);
+        uint64_t hashLow, hashHigh;
+        hashPackedRead(read, packedLength, hashLow, hashHigh);
+        // fingerprint 0 marks a slot claimed by a read that is not yet fingerprinted
+        const uint32_t fingerprint = (uint32_t) hashHigh | 1;
+        uint_reads_cnt_max slot = hashLow & slotsMask;
+        while (true) {
+            uint_reads_cnt slotIdx = __atomic_load_n(&table[slot].idx, __ATOMIC_ACQUIRE);
+            if (slotIdx == 0) {
+                assert(insertMode);
+                if (__sync_bool_compare_and_swap(&table[slot].idx, 0, incIdx)) {
+                    __atomic_store_n(&table[slot].fingerprint, fingerprint, __ATOMIC_RELEASE);
+                    return slot;
+                }
+                continue;
+            }
+            const uint32_t slotFingerprint = __atomic_load_n(&table[slot].fingerprint, __ATOMIC_ACQUIRE);
+            if ((slotFingerprint == 0 || slotFingerprint == fingerprint) &&
+                memcmp(packedReadsSet->getPackedRead(slotIdx - 1), read, packedLength) == 0) {
+                while (insertMode && incIdx < slotIdx && !__sync_bool_compare_and_swap(&table[slot].idx, slotIdx, incIdx))
+                    slotIdx = __atomic_load_n(&table[slot].idx, __ATOMIC_ACQUIRE);
+                return slot;
+            }
+            slot = (slot + 1) & slotsMask;
+        }
+    }
+
+    // identical reads are chained (by increasing indexes) after the lowest index read;
+    // returns indexes of the chains' heads in increasing order
+    template<typename uint_read_len, typename uint_reads_cnt>
+    template<bool avoidCyclesMode>
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::collapseDuplicates(
+            vector<uint_reads_cnt> &uniqueReadsIdxs) {
+        const uint_reads_cnt readsCount = readsTotal();
+        const uint_read_len readLength = packedReadsSet->maxReadLength();
+        uint_reads_cnt_max slotsCount = 1;
+        while (slotsCount < readsCount * DUPLICATES_TABLE_MIN_SLOTS_PER_READ)
+            slotsCount *= 2;
+        const uint_reads_cnt_max slotsMask = slotsCount - 1;
+        // each read adds either its index (unique reads) or a duplicate entry
+        const uint64_t tableBytes = slotsCount * sizeof(DuplicatesTableSlot);
+        const uint64_t entriesBytes = (uint64_t) readsCount * sizeof(DuplicateEntry);
+        const bool spillTable = maxMemoryUsage && residentBytes() + tableBytes + entriesBytes > maxMemoryUsage;
+        if (spillTable)
+            *logout << "Spilling duplicates table to a temporary file (" << tableBytes / 1024 / 1024 << " MB)" << endl;
+        SpillableArray<DuplicatesTableSlot> table;
+        table.allocate(slotsCount, spillTable);
+        #pragma omp parallel for schedule(guided)
+        for (uint_reads_cnt_max incIdx = 1; incIdx <= readsCount; incIdx++)
+            findDuplicatesTableSlot(table.data(), slotsMask, incIdx, true);
+
+        vector<vector<DuplicateEntry>> threadDuplicates(numberOfThreads);
+        vector<vector<uint_reads_cnt>> threadUniqueIdxs(numberOfThreads);
+        uint_reads_cnt duplicatesCount = 0;
+        #pragma omp parallel for reduction(+:duplicatesCount)
+        for (int t = 0; t < numberOfThreads; t++) {
+            vector<DuplicateEntry> &duplicates = threadDuplicates[t];
+            const uint_reads_cnt endIdx = 1 + (uint_reads_cnt_max) readsCount * (t + 1) / numberOfThreads;
+            for (uint_reads_cnt incIdx = 1 + (uint_reads_cnt_max) readsCount * t / numberOfThreads; incIdx < endIdx; incIdx++) {
+                const uint_reads_cnt_max slot = findDuplicatesTableSlot(table.data(), slotsMask, incIdx, false);
+                if (table[slot].idx == incIdx)
+                    threadUniqueIdxs[t].push_back(incIdx);
+                else
+                    duplicates.push_back({ slot, incIdx });
+            }
+            duplicatesCount += duplicates.size();
+            std::sort(duplicates.begin(), duplicates.end());
+            for (size_t i = 1; i < duplicates.size(); i++)
+                if (duplicates[i].slot == duplicates[i - 1].slot)
+                    this->setDuplicateSuccessor<avoidCyclesMode>(duplicates[i - 1].idx, duplicates[i].idx, readLength);
+        }
+        // runs of duplicates found in consecutive ranges are joined in order (one run per slot in a range)
+        for (int t = 0; t < numberOfThreads; t++) {
+            const vector<DuplicateEntry> &duplicates = threadDuplicates[t];
+            #pragma omp parallel for
+            for (size_t i = 0; i < duplicates.size(); i++) {
+                if (i && duplicates[i - 1].slot == duplicates[i].slot)
+                    continue;
+                size_t last = i;
+                while (last + 1 < duplicates.size() && duplicates[last + 1].slot == duplicates[i].slot)
+                    last++;
+                DuplicatesTableSlot &slot = table[duplicates[i].slot];
+                this->setDuplicateSuccessor<avoidCyclesMode>(slot.tail ? slot.tail : slot.idx, duplicates[i].idx, readLength);
+                slot.tail = duplicates[last].idx;
+            }
+            vector<DuplicateEntry>().swap(threadDuplicates[t]);
+        }
+        table.clear();
+
+        uniqueReadsIdxs.reserve(readsCount - duplicatesCount);
+        for (int t = 0; t < numberOfThreads; t++) {
+            uniqueReadsIdxs.insert(uniqueReadsIdxs.end(), threadUniqueIdxs[t].begin(), threadUniqueIdxs[t].end());
+            vector<uint_reads_cnt>().swap(threadUniqueIdxs[t]);
+        }
+        this->readsLeft -= duplicatesCount;
+        cout << "Found " << duplicatesCount << " duplicates (..." << time_millis() << " msec)" << endl;
+    }
+
+    template<typename uint_read_len, typename uint_reads_cnt>
+    uint_reads_cnt ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::getDuplicatesTail(
+            uint_reads_cnt incIdx) {
+        while (this->nextRead[incIdx])
+            incIdx = this->nextRead[incIdx];
+        return incIdx;
     }
 
     template<typename uint_read_len, typename uint_reads_cnt>
     template<bool avoidCyclesMode>
     void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::initAndFindDuplicates() {
         auto start_t = chrono::steady_clock::now();
-        prepareSortedReadsBlocks();
-        uint16_t b = 0;
+        vector<uint_reads_cnt> uniqueReadsIdxs;
+        collapseDuplicates<avoidCyclesMode>(uniqueReadsIdxs);
+        planIndexesMemory();
+        prepareSortedReadsBlocks(uniqueReadsIdxs);
+        vector<uint_reads_cnt>().swap(uniqueReadsIdxs);
+        uint32_t b = 0;
         threadStartBlock[UINT8_MAX] = 0;
         for(uint8_t t = 1; t <= numberOfThreads; t++) {
             uint_reads_cnt threshold = ((double) t / numberOfThreads) * this->readsLeft;
@@ -148,98 +442,84 @@ namespace PgSAIndex {
             threadStartBlock[t] = b;
         }
         threadStartBlock[numberOfThreads] = blocksCount;
-        uint_reads_cnt sortedSuffixesLeftCount[MAX_BLOCKS_COUNT] = { 0 };
-        uint_reads_cnt duplicatesCount = 0;
-        #pragma omp parallel for reduction(+:sortedSuffixesLeftCount[0:MAX_BLOCKS_COUNT]) reduction(+:duplicatesCount)
+        const uint32_t curBlocksCount = blocksCount;
+        vector<uint_reads_cnt> sortedSuffixesLeftCountVector(curBlocksCount, 0);
+        uint_reads_cnt* sortedSuffixesLeftCount = sortedSuffixesLeftCountVector.data();
+        #pragma omp parallel for reduction(+:sortedSuffixesLeftCount[0:curBlocksCount])
         for(uint8_t t = 0; t < numberOfThreads; t++)
         {
-            for (uint16_t b = threadStartBlock[t]; b < threadStartBlock[t + 1]; b++)
+            for (uint32_t b = threadStartBlock[t]; b < threadStartBlock[t + 1]; b++)
             {
                 sortedReadsCount[b] = sortedReadsBlockPos[b + 1] - sortedReadsBlockPos[b];
                 uchar curSymOrder = 0;
                 sortedSuffixBlockPlusSymbolPos[b][curSymOrder] = sortedReadsBlockPos[b];
-                if (sortedReadsCount[b]) {
-                    uint16_t youngestNextSuffixBlock = (b % (blocksCount / symbolsCount)) * symbolsCount;
-                    const auto &blockEnd = sortedReadsIdxs.begin() + sortedReadsBlockPos[b + 1];
-                    for (auto srIt = sortedReadsIdxs.begin() + sortedReadsBlockPos[b]; srIt != blockEnd;) {
-                        srIt++;
-                        if (srIt != blockEnd && compareReads(*(srIt - 1), *srIt) == 0) {
-                            if (avoidCyclesMode)
-                                this->setDuplicateSuccessor<true>(*(srIt - 1), *srIt, packedReadsSet->maxReadLength());
-                            else
-                                this->setDuplicateSuccessor<false>(*(srIt - 1), *srIt, packedReadsSet->maxReadLength());
-                            duplicatesCount++;
-                        } else {
-                            uchar nextSuffixSymbolOrder = getSymbolOrderFromRead(*(srIt - 1), blockPrefixLength);
-                            sortedSuffixesLeftCount[youngestNextSuffixBlock + nextSuffixSymbolOrder]++;
-                            while (curSymOrder != nextSuffixSymbolOrder)
-                                sortedSuffixBlockPlusSymbolPos[b][++curSymOrder] = (srIt - 1) - sortedReadsIdxs.begin();
-                        }
-                    }
+                uint32_t youngestNextSuffixBlock = (b % (blocksCount / symbolsCount)) * symbolsCount;
+                const auto &blockEnd = sortedReadsIdxs.begin() + sortedReadsBlockPos[b + 1];
+                for (auto srIt = sortedReadsIdxs.begin() + sortedReadsBlockPos[b]; srIt != blockEnd; srIt++) {
+                    uchar nextSuffixSymbolOrder = getSymbolOrderFromRead(*srIt, blockPrefixLength);
+                    sortedSuffixesLeftCount[youngestNextSuffixBlock + nextSuffixSymbolOrder]++;
+                    while (curSymOrder != nextSuffixSymbolOrder)
+                        sortedSuffixBlockPlusSymbolPos[b][++curSymOrder] = srIt - sortedReadsIdxs.begin();
                 }
                 while (curSymOrder < symbolsCount)
                     sortedSuffixBlockPlusSymbolPos[b][++curSymOrder] = sortedReadsBlockPos[b + 1];
             }
         }
-        this->readsLeft -= duplicatesCount;
         assert(accumulate(sortedSuffixesLeftCount, sortedSuffixesLeftCount + blocksCount, 0) == this->readsLeft);
-        cout << "Found " << (readsTotal() - this->readsLeft) << " duplicates (..." << time_millis() << " msec)" << endl;
-        sortedSuffixIdxs.resize(this->readsLeft, 0);
-        mergeSortOfLeftSuffixes(1, sortedSuffixesLeftCount, sortedSuffixIdxs.data(), sortedReadsIdxs.data());
 
-        #pragma omp parallel for schedule(guided)
-        for(uint16_t b = 0; b < blocksCount; b++) {
-            if (!sortedReadsCount[b])
-                continue;
-            uint_reads_cnt i = sortedReadsBlockPos[b];
-            for (uint_reads_cnt j = i; j < sortedReadsBlockPos[b] + sortedReadsCount[b]; j++) {
-                if (j == 0 || this->nextRead[sortedReadsIdxs[j - 1]] == 0)
-                    sortedReadsIdxs[i++] = sortedReadsIdxs[j];
-            }
-            sortedReadsCount[b] = i - sortedReadsBlockPos[b];
-        }
-        assert(accumulate(sortedReadsCount, sortedReadsCount + blocksCount, 0) == this->readsLeft);
+        // reads are prefixes as the heads and suffixes as the tails of their duplicates chains
+        SpillableArray<uint_reads_cnt> sortedTailsIdxs;
+        sortedTailsIdxs.allocate(this->readsLeft, spillIndexes);
+        #pragma omp parallel for
+        for (uint_reads_cnt_max i = 0; i < this->readsLeft; i++)
+            sortedTailsIdxs[i] = getDuplicatesTail(sortedReadsIdxs[i]);
+        sortedSuffixIdxs.allocate(this->readsLeft, spillIndexes);
+        mergeSortOfLeftSuffixes(1, sortedSuffixesLeftCount, sortedSuffixIdxs, sortedTailsIdxs.data());
     }
 
     template<typename uint_read_len, typename uint_reads_cnt>
     void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::mergeSortOfLeftSuffixes(
-            uint_read_len offset, const uint_reads_cnt *sortedSuffixesLeftCount, uint_reads_cnt *sortedSuffixLeftIdxsPtr,
-            const uint_reads_cnt *sortedSuffixIdxsPtr) {
+            uint_read_len offset, const uint_reads_cnt *sortedSuffixesLeftCount,
+            SpillableArray<uint_reads_cnt> &sortedSuffixLeftIdxs, const uint_reads_cnt *sortedSuffixIdxsPtr) {
         sortedSuffixBlockPos[0] = 0;
-        for(uint16_t b = 1; b <= blocksCount; b++)
+        for(uint32_t b = 1; b <= blocksCount; b++)
             sortedSuffixBlockPos[b] = sortedSuffixBlockPos[b - 1] + sortedSuffixesLeftCount[b - 1];
 
         this->sortedSuffixIdxsPtr = sortedSuffixIdxsPtr;
-        #pragma omp parallel for schedule(guided)
-        for(uint16_t b = 0; b < blocksCount; b++)
-        {
-            uint16_t prevYoungestBlock = b / symbolsCount;
-            uint8_t lastPrefixSymbolOrder = b % symbolsCount;
-            uint_reads_cnt ssiSymbolIdx[MAX_SYMBOLS_COUNT];
-            uint_reads_cnt ssiSymbolEnd[MAX_SYMBOLS_COUNT];
-            for (uint8_t j = 0; j < symbolsCount; j++) {
-                ssiSymbolIdx[j] = sortedSuffixBlockPlusSymbolPos[prevYoungestBlock + (blocksCount / symbolsCount) * j]
-                [lastPrefixSymbolOrder];
-                ssiSymbolEnd[j] = sortedSuffixBlockPlusSymbolPos[prevYoungestBlock + (blocksCount / symbolsCount) * j]
-                [lastPrefixSymbolOrder + 1];
-            }
-            deque<uchar> ssiOrder;
-            for (uint8_t j = 0; j < symbolsCount; j++) {
-                while (ssiSymbolIdx[j] < ssiSymbolEnd[j] &&
-                       this->nextRead[sortedSuffixIdxsPtr[ssiSymbolIdx[j]]] != 0)
-                    ssiSymbolIdx[j]++;
-                updateSuffixQueue(j, offset + blockPrefixLength, ssiSymbolIdx, ssiSymbolEnd, ssiOrder);
-            }
-            uint_reads_cnt curPos = sortedSuffixBlockPos[b];
-            while (!ssiOrder.empty()) {
-                uchar j = ssiOrder.front();
-                uint_reads_cnt sufIdx = sortedSuffixIdxsPtr[ssiSymbolIdx[j]];
-                sortedSuffixLeftIdxsPtr[curPos++] = sufIdx;
-                ssiOrder.pop_front();
-                while (++ssiSymbolIdx[j] < ssiSymbolEnd[j] &&
-                        this->nextRead[sortedSuffixIdxsPtr[ssiSymbolIdx[j]]] != 0);
-                updateSuffixQueue(j, offset + blockPrefixLength, ssiSymbolIdx, ssiSymbolEnd, ssiOrder);
+        uint_reads_cnt* sortedSuffixLeftIdxsPtr = sortedSuffixLeftIdxs.data();
+        vector<uint32_t> groupsEnds;
+        findBlocksGroupsEnds(blocksCount, groupsEnds);
+        uint32_t groupStart = 0;
+        for (const uint32_t groupEnd: groupsEnds) {
+            #pragma omp parallel for schedule(guided)
+            for(uint32_t b = groupStart; b < groupEnd; b++)
+            {
+                uint32_t prevYoungestBlock = b / symbolsCount;
+                uint8_t lastPrefixSymbolOrder = b % symbolsCount;
+                SuffixGroupHead heads[MAX_SYMBOLS_COUNT];
+                uint_reads_cnt turn = 0;
+                for (uint8_t j = 0; j < symbolsCount; j++) {
+                    heads[j].pos = sortedSuffixBlockPlusSymbolPos[prevYoungestBlock + (blocksCount / symbolsCount) * j]
+                    [lastPrefixSymbolOrder];
+                    heads[j].end = sortedSuffixBlockPlusSymbolPos[prevYoungestBlock + (blocksCount / symbolsCount) * j]
+                    [lastPrefixSymbolOrder + 1];
+                    updateSuffixGroupHead(heads[j], offset + blockPrefixLength, turn);
+                }
+                uint_reads_cnt curPos = sortedSuffixBlockPos[b];
+                while (true) {
+                    int8_t first = -1;
+                    for (uint8_t j = 0; j < symbolsCount; j++)
+                        if (heads[j].pos < heads[j].end &&
+                            (first == -1 || isSuffixGroupHeadFirst(heads[j], heads[first], offset + blockPrefixLength)))
+                            first = j;
+                    if (first == -1)
+                        break;
+                    sortedSuffixLeftIdxsPtr[curPos++] = sortedSuffixIdxsPtr[heads[first].pos++];
+                    updateSuffixGroupHead(heads[first], offset + blockPrefixLength, turn);
+                }
             }
+            sortedSuffixLeftIdxs.evict(sortedSuffixBlockPos[groupStart], sortedSuffixBlockPos[groupEnd]);
+            groupStart = groupEnd;
         }
     }
 
@@ -251,13 +531,14 @@ namespace PgSAIndex {
         *logout << "Start overlapping.\n";
 
         uint_read_len overlapIterations = packedReadsSet->maxReadLength() * overlappedReadsCountStopCoef;
-        uint16_t curBlocksCount = blocksCount;
+        uint32_t curBlocksCount = blocksCount;
         for (int i = 1; i < overlapIterations; i++) {
             if (i < packedReadsSet->maxReadLength() - blockPrefixLength) {
-                uint_reads_cnt sortedSuffixesLeftCount[MAX_BLOCKS_COUNT] = {0};
-                overlapSortedReadsAndSuffixes<false>(i, sortedSuffixesLeftCount);
-                vector<uint_reads_cnt> sortedSuffixLeft(this->readsLeft, 0);
-                mergeSortOfLeftSuffixes(i + 1, sortedSuffixesLeftCount, sortedSuffixLeft.data(),
+                vector<uint_reads_cnt> sortedSuffixesLeftCount(blocksCount, 0);
+                overlapSortedReadsAndSuffixes<false>(i, sortedSuffixesLeftCount.data());
+                SpillableArray<uint_reads_cnt> sortedSuffixLeft;
+                sortedSuffixLeft.allocate(this->readsLeft, spillIndexes);
+                mergeSortOfLeftSuffixes(i + 1, sortedSuffixesLeftCount.data(), sortedSuffixLeft,
                                         sortedSuffixIdxs.data());
                 sortedSuffixIdxs.swap(sortedSuffixLeft);
             } else {
@@ -270,9 +551,7 @@ namespace PgSAIndex {
         }
 
         sortedReadsIdxs.clear();
-        sortedReadsIdxs.shrink_to_fit();
         sortedSuffixIdxs.clear();
-        sortedSuffixIdxs.shrink_to_fit();
 
         if (pgGenerationMode) {
             this->removeCyclesAndPrepareComponents();
@@ -290,29 +569,129 @@ namespace PgSAIndex {
         uint8_t threadsInIteration = suffixesOffset<25?2:(suffixesOffset<40?4:numberOfThreads);
         if (!avoidCyclesMode || threadsInIteration > numberOfThreads)
             threadsInIteration = numberOfThreads;
+        const uint32_t curBlocksCount = blocksCount;
+        uint_reads_cnt overlapsCount = 0;
 
-        uint16_t b = 0;
-        uint_reads_cnt readsAndSuffixesCount = 0;
-        threadStartBlock[UINT8_MAX] = 0;
-        for(uint8_t t = 1; t <= threadsInIteration; t++) {
-            uint_reads_cnt threshold = ((double) t / threadsInIteration) * this->readsLeft * 2;
-            while (readsAndSuffixesCount < threshold) {
-                readsAndSuffixesCount += sortedReadsCount[b] + sortedSuffixBlockPos[b + 1] - sortedSuffixBlockPos[b];
-                b++;
+        vector<uint32_t> groupsEnds;
+        findBlocksGroupsEnds(blocksCount, groupsEnds);
+        uint32_t groupStart = 0;
+        for (const uint32_t groupEnd: groupsEnds) {
+            uint_reads_cnt_max groupIndexesCount = 0;
+            for (uint32_t b = groupStart; b < groupEnd; b++)
+                groupIndexesCount += sortedReadsCount[b] + sortedSuffixBlockPos[b + 1] - sortedSuffixBlockPos[b];
+            uint32_t b = groupStart;
+            uint_reads_cnt_max readsAndSuffixesCount = 0;
+            threadStartBlock[0] = groupStart;
+            for(uint8_t t = 1; t <= threadsInIteration; t++) {
+                uint_reads_cnt_max threshold = ((double) t / threadsInIteration) * groupIndexesCount;
+                while (readsAndSuffixesCount < threshold) {
+                    readsAndSuffixesCount += sortedReadsCount[b] + sortedSuffixBlockPos[b + 1] - sortedSuffixBlockPos[b];
+                    b++;
+                }
+                threadStartBlock[t] = b;
             }
-            threadStartBlock[t] = b;
+            threadStartBlock[threadsInIteration] = groupEnd;
+#pragma omp parallel for reduction(+:sortedSuffixesLeftCount[0:curBlocksCount]) num_threads(threadsInIteration) \
+                        reduction(+:overlapsCount)
+            for(uint8_t t = 0; t < threadsInIteration; t++)
+            {
+                for (uint32_t b = threadStartBlock[t]; b < threadStartBlock[t + 1]; b++)
+                {
+                    uchar curSymOrder = 0;
+                    sortedSuffixBlockPlusSymbolPos[b][curSymOrder] = sortedSuffixBlockPos[b];
+                    uint32_t youngestNextSuffixBlock = (b % (blocksCount / symbolsCount)) * symbolsCount;
+                    auto preIt = sortedReadsIdxs.begin() + sortedReadsBlockPos[b];
+                    auto sufIt = sortedSuffixIdxs.begin() + sortedSuffixBlockPos[b];
+                    const auto &preEnd = preIt + sortedReadsCount[b];
+                    const auto &sufEnd = sortedSuffixIdxs.begin() + sortedSuffixBlockPos[b + 1];
+                    sortedReadsCount[b] = 0;
+                    while (sufIt != sufEnd || preIt != preEnd) {
+                        if (sufIt == sufEnd)
+                            sortedReadsIdxs[sortedReadsBlockPos[b] + sortedReadsCount[b]++] = (*(preIt++));
+                        else {
+                            int cmpRes = -1;
+                            auto curPreIt = preIt;
+                            while (preIt != preEnd) {
+                                if ((cmpRes = compareSuffixWithPrefix(*sufIt, *preIt, suffixesOffset)) != 0)
+                                    break;
+                                if ((*sufIt != *preIt) && (!avoidCyclesMode || !this->isHeadOf(*sufIt, *preIt)))
+                                    break;
+                                cmpRes = -1;
+                                preIt++;
+                            }
+
+                            if (cmpRes)
+                                preIt = curPreIt;
+                            else {
+                                uint_reads_cnt preIdx = *preIt;
+                                while (preIt > curPreIt) {
+                                    *preIt = *(preIt - 1);
+                                    preIt--;
+                                }
+                                *preIt = preIdx;
+                            }
+
+                            if (cmpRes == 0) {
+                                if (avoidCyclesMode) {
+                                    bool cycleCheck = false;
+#pragma omp critical
+                                    {
+                                        if (!(cycleCheck = this->isHeadOf(*sufIt, *preIt))) {
+                                            if (this->headRead[*sufIt] == 0)
+                                                this->headRead[*preIt] = *sufIt;
+                                            else
+                                                this->headRead[*preIt] = this->headRead[*sufIt];
+                                        }
+                                    }
+                                    if (cycleCheck)
+                                        continue;
+                                }
+                                this->setReadSuccessor(*sufIt, *preIt,
+                                                           packedReadsSet->maxReadLength() - suffixesOffset);
+                                overlapsCount++;
+                                preIt++;
+                            } else if (cmpRes > 0) {
+                                sortedReadsIdxs[sortedReadsBlockPos[b] + sortedReadsCount[b]++] = (*(preIt++));
+                                continue;
+                            } else {
+                                uchar nextSuffixSymbolOrder = getSymbolOrderFromRead(*sufIt, suffixesOffset +
+                                                                                             blockPrefixLength);
+                                sortedSuffixesLeftCount[youngestNextSuffixBlock + nextSuffixSymbolOrder]++;
+                                while (curSymOrder != nextSuffixSymbolOrder)
+                                    sortedSuffixBlockPlusSymbolPos[b][++curSymOrder] = sufIt - sortedSuffixIdxs.begin();
+                            }
+                            sufIt++;
+                        }
+                    }
+                    while (curSymOrder < symbolsCount)
+                        sortedSuffixBlockPlusSymbolPos[b][++curSymOrder] = sortedSuffixBlockPos[b + 1];
+                }
+            }
+            sortedReadsIdxs.evict(sortedReadsBlockPos[groupStart], sortedReadsBlockPos[groupEnd]);
+            sortedSuffixIdxs.evict(sortedSuffixBlockPos[groupStart], sortedSuffixBlockPos[groupEnd]);
+            groupStart = groupEnd;
         }
-        threadStartBlock[numberOfThreads] = blocksCount;
+        this->readsLeft -= overlapsCount;
+        assert(accumulate(sortedSuffixesLeftCount, sortedSuffixesLeftCount + blocksCount, 0) == this->readsLeft);
+    }
+
+    template<typename uint_read_len, typename uint_reads_cnt>
+    template<bool avoidCyclesMode>
+    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::
+    blockPrefixOverlapSortedReadsAndSuffixesWithAfterSuffixMerge(uint_read_len suffixesOffset, uint32_t curBlocksCount) {
+        vector<uint_reads_cnt> sortedSuffixesLeftCountVector(curBlocksCount, 0);
+        uint_reads_cnt* sortedSuffixesLeftCount = sortedSuffixesLeftCountVector.data();
         uint_reads_cnt overlapsCount = 0;
-#pragma omp parallel for reduction(+:sortedSuffixesLeftCount[0:MAX_BLOCKS_COUNT]) num_threads(threadsInIteration) \
-                        reduction(+:overlapsCount)
-        for(uint8_t t = 0; t < threadsInIteration; t++)
-        {
-            for (uint16_t b = threadStartBlock[t]; b < threadStartBlock[t + 1]; b++)
+
+        vector<uint32_t> groupsEnds;
+        findBlocksGroupsEnds(curBlocksCount, groupsEnds);
+        uint32_t groupStart = 0;
+        for (const uint32_t groupEnd: groupsEnds) {
+            const uint_reads_cnt groupReadsEnd = sortedReadsBlockPos[groupEnd - 1] + sortedReadsCount[groupEnd - 1];
+#pragma omp parallel for schedule(guided) reduction(+:sortedSuffixesLeftCount[0:curBlocksCount]) reduction(+:overlapsCount)
+            for (uint32_t b = groupStart; b < groupEnd; b++)
             {
-                uchar curSymOrder = 0;
-                sortedSuffixBlockPlusSymbolPos[b][curSymOrder] = sortedSuffixBlockPos[b];
-                uint16_t youngestNextSuffixBlock = (b % (blocksCount / symbolsCount)) * symbolsCount;
+                uint32_t nextSuffixBlock = (b % (curBlocksCount / symbolsCount));
                 auto preIt = sortedReadsIdxs.begin() + sortedReadsBlockPos[b];
                 auto sufIt = sortedSuffixIdxs.begin() + sortedSuffixBlockPos[b];
                 const auto &preEnd = preIt + sortedReadsCount[b];
@@ -325,8 +704,7 @@ namespace PgSAIndex {
                         int cmpRes = -1;
                         auto curPreIt = preIt;
                         while (preIt != preEnd) {
-                            if ((cmpRes = compareSuffixWithPrefix(*sufIt, *preIt, suffixesOffset)) != 0)
-                                break;
+                            cmpRes = 0;
                             if ((*sufIt != *preIt) && (!avoidCyclesMode || !this->isHeadOf(*sufIt, *preIt)))
                                 break;
                             cmpRes = -1;
@@ -360,103 +738,27 @@ namespace PgSAIndex {
                                     continue;
                             }
                             this->setReadSuccessor(*sufIt, *preIt,
-                                                       packedReadsSet->maxReadLength() - suffixesOffset);
+                                                   packedReadsSet->maxReadLength() - suffixesOffset);
                             overlapsCount++;
                             preIt++;
-                        } else if (cmpRes > 0) {
-                            sortedReadsIdxs[sortedReadsBlockPos[b] + sortedReadsCount[b]++] = (*(preIt++));
-                            continue;
                         } else {
-                            uchar nextSuffixSymbolOrder = getSymbolOrderFromRead(*sufIt, suffixesOffset +
-                                                                                         blockPrefixLength);
-                            sortedSuffixesLeftCount[youngestNextSuffixBlock + nextSuffixSymbolOrder]++;
-                            while (curSymOrder != nextSuffixSymbolOrder)
-                                sortedSuffixBlockPlusSymbolPos[b][++curSymOrder] = sufIt - sortedSuffixIdxs.begin();
+                            sortedSuffixesLeftCount[nextSuffixBlock]++;
                         }
                         sufIt++;
                     }
                 }
-                while (curSymOrder < symbolsCount)
-                    sortedSuffixBlockPlusSymbolPos[b][++curSymOrder] = sortedSuffixBlockPos[b + 1];
-            }
-        }
-        this->readsLeft -= overlapsCount;
-        assert(accumulate(sortedSuffixesLeftCount, sortedSuffixesLeftCount + blocksCount, 0) == this->readsLeft);
-    }
-
-    template<typename uint_read_len, typename uint_reads_cnt>
-    template<bool avoidCyclesMode>
-    void ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>::
-    blockPrefixOverlapSortedReadsAndSuffixesWithAfterSuffixMerge(uint_read_len suffixesOffset, uint16_t curBlocksCount) {
-        uint_reads_cnt sortedSuffixesLeftCount[MAX_BLOCKS_COUNT] = {0};
-        uint_reads_cnt overlapsCount = 0;
-#pragma omp parallel for schedule(guided) reduction(+:sortedSuffixesLeftCount[0:MAX_BLOCKS_COUNT]) reduction(+:overlapsCount)
-        for (uint16_t b = 0; b < curBlocksCount; b++)
-        {
-            uint16_t nextSuffixBlock = (b % (curBlocksCount / symbolsCount));
-            auto preIt = sortedReadsIdxs.begin() + sortedReadsBlockPos[b];
-            auto sufIt = sortedSuffixIdxs.begin() + sortedSuffixBlockPos[b];
-            const auto &preEnd = preIt + sortedReadsCount[b];
-            const auto &sufEnd = sortedSuffixIdxs.begin() + sortedSuffixBlockPos[b + 1];
-            sortedReadsCount[b] = 0;
-            while (sufIt != sufEnd || preIt != preEnd) {
-                if (sufIt == sufEnd)
-                    sortedReadsIdxs[sortedReadsBlockPos[b] + sortedReadsCount[b]++] = (*(preIt++));
-                else {
-                    int cmpRes = -1;
-                    auto curPreIt = preIt;
-                    while (preIt != preEnd) {
-                        cmpRes = 0;
-                        if ((*sufIt != *preIt) && (!avoidCyclesMode || !this->isHeadOf(*sufIt, *preIt)))
-                            break;
-                        cmpRes = -1;
-                        preIt++;
-                    }
-
-                    if (cmpRes)
-                        preIt = curPreIt;
-                    else {
-                        uint_reads_cnt preIdx = *preIt;
-                        while (preIt > curPreIt) {
-                            *preIt = *(preIt - 1);
-                            preIt--;
-                        }
-                        *preIt = preIdx;
-                    }
-
-                    if (cmpRes == 0) {
-                        if (avoidCyclesMode) {
-                            bool cycleCheck = false;
-#pragma omp critical
-                            {
-                                if (!(cycleCheck = this->isHeadOf(*sufIt, *preIt))) {
-                                    if (this->headRead[*sufIt] == 0)
-                                        this->headRead[*preIt] = *sufIt;
-                                    else
-                                        this->headRead[*preIt] = this->headRead[*sufIt];
-                                }
-                            }
-                            if (cycleCheck)
-                                continue;
-                        }
-                        this->setReadSuccessor(*sufIt, *preIt,
-                                               packedReadsSet->maxReadLength() - suffixesOffset);
-                        overlapsCount++;
-                        preIt++;
-                    } else {
-                        sortedSuffixesLeftCount[nextSuffixBlock]++;
-                    }
-                    sufIt++;
-                }
             }
+            sortedReadsIdxs.evict(sortedReadsBlockPos[groupStart], groupReadsEnd);
+            sortedSuffixIdxs.evict(sortedSuffixBlockPos[groupStart], sortedSuffixBlockPos[groupEnd]);
+            groupStart = groupEnd;
         }
         this->readsLeft -= overlapsCount;
         assert(accumulate(sortedSuffixesLeftCount, sortedSuffixesLeftCount + (curBlocksCount / symbolsCount), 0) == this->readsLeft);
 
         if (curBlocksCount > symbolsCount) {
 #pragma omp parallel for schedule(guided)
-            for (uint16_t b = 0; b < curBlocksCount / symbolsCount; b++) {
-                const uint16_t rootBlock = b * symbolsCount;
+            for (uint32_t b = 0; b < curBlocksCount / symbolsCount; b++) {
+                const uint32_t rootBlock = b * symbolsCount;
                 auto srIt = sortedReadsIdxs.begin() + sortedReadsBlockPos[rootBlock] + sortedReadsCount[rootBlock];
                 for (uint8_t b2 = 1; b2 < symbolsCount; b2++) {
                     auto it = sortedReadsIdxs.begin() + sortedReadsBlockPos[rootBlock + b2];
@@ -466,22 +768,23 @@ namespace PgSAIndex {
                 }
                 sortedReadsCount[rootBlock] = srIt - (sortedReadsIdxs.begin() + sortedReadsBlockPos[rootBlock]);
             }
-            for (uint16_t b = 1; b < curBlocksCount / symbolsCount; b++) {
-                const uint16_t prevBlock = b * symbolsCount;
+            for (uint32_t b = 1; b < curBlocksCount / symbolsCount; b++) {
+                const uint32_t prevBlock = b * symbolsCount;
                 sortedReadsBlockPos[b] = sortedReadsBlockPos[prevBlock];
                 sortedReadsCount[b] = sortedReadsCount[prevBlock];
             }
-            for(uint16_t b = 0; b <= curBlocksCount; b++)
+            for(uint32_t b = 0; b <= curBlocksCount; b++)
                 sortedSuffixBlockPlusSymbolPos[b][0] = sortedSuffixBlockPos[b];
             sortedSuffixBlockPos[0] = 0;
-            for(uint16_t b = 1; b <= curBlocksCount / symbolsCount; b++)
+            for(uint32_t b = 1; b <= curBlocksCount / symbolsCount; b++)
                 sortedSuffixBlockPos[b] = sortedSuffixBlockPos[b - 1] + sortedSuffixesLeftCount[b - 1];
 
-            vector<uint_reads_cnt> sortedSuffixLeft(this->readsLeft, 0);
+            SpillableArray<uint_reads_cnt> sortedSuffixLeft;
+            sortedSuffixLeft.allocate(this->readsLeft, spillIndexes);
 #pragma omp parallel for schedule(guided)
-            for (uint16_t b = 0; b < curBlocksCount / symbolsCount; b++) {
+            for (uint32_t b = 0; b < curBlocksCount / symbolsCount; b++) {
                 auto leftIt = sortedSuffixLeft.begin() + sortedSuffixBlockPos[b];
-                for (uint16_t b2 = b; b2 < curBlocksCount; b2 += (curBlocksCount / symbolsCount)) {
+                for (uint32_t b2 = b; b2 < curBlocksCount; b2 += (curBlocksCount / symbolsCount)) {
                     auto it = sortedSuffixIdxs.begin() + sortedSuffixBlockPlusSymbolPos[b2][0];
                     const auto &endIt = sortedSuffixIdxs.begin() + sortedSuffixBlockPlusSymbolPos[b2 + 1][0];
                     while (it != endIt) {
@@ -521,6 +824,8 @@ namespace PgSAIndex {
 
         if (isReadsCountStd(readsSet->readsCount()))
             return getGeneratorFullTemplate<uint_read_len, uint_reads_cnt_std>(readsSet, ownReadsSet);
+        else if (isReadsCountMax(readsSet->readsCount()))
+            return getGeneratorFullTemplate<uint_read_len, uint_reads_cnt_max>(readsSet, ownReadsSet);
         else
             cout << "UNSUPPORTED READS COUNT!!!???";
 
@@ -4,13 +4,18 @@
 #include "PseudoGenomeGeneratorBase.h"
 #include "AbstractOverlapPseudoGenomeGenerator.h"
 #include "../../readsset/PackedConstantLengthReadsSet.h"
+#include "../../utils/SpillableArray.h"
 #include <algorithm>
-#include <deque>
+#include <array>
 
-#define MAX_BLOCK_PREFIX_LENGTH 4
+#define MIN_BLOCK_PREFIX_LENGTH 3
+#define MAX_BLOCK_PREFIX_LENGTH 8
+#define MIN_AVERAGE_READS_PER_BLOCK 256
+#define BLOCK_BALANCE_FACTOR 4 // max block reads count limit: 1 / (BLOCK_BALANCE_FACTOR * numberOfThreads) of all reads
 #define MAX_SYMBOLS_COUNT 5
-#define MAX_BLOCKS_COUNT 625 // MAX_SYMBOLS_COUNT^MAX_BLOCK_PREFIX_LENGTH
 #define PARALLEL_PG_GENERATION_READS_COUNT_THRESHOLD 50000
+#define RADIX_SORT_INSERTION_SORT_THRESHOLD 32
+#define DUPLICATES_TABLE_MIN_SLOTS_PER_READ 1.5
 
 using namespace PgSAReadsSet;
 
@@ -25,30 +30,25 @@ namespace PgSAIndex {
         PackedConstantLengthReadsSet* packedReadsSet = 0;
         const uint_symbols_cnt symbolsCount;
 
-        vector<uint_reads_cnt> sortedReadsIdxs;
-        vector<uint_reads_cnt> sortedSuffixIdxs;
+        SpillableArray<uint_reads_cnt> sortedReadsIdxs;
+        SpillableArray<uint_reads_cnt> sortedSuffixIdxs;
         const uint_reads_cnt* sortedSuffixIdxsPtr;
 
-        const uint8_t blockPrefixLength = 3;
-        char blockPrefixes[MAX_BLOCKS_COUNT][MAX_SYMBOLS_COUNT] = { 0 };
-        uint16_t blocksCount;
+        // out-of-core mode (maxMemoryUsage exceeded): indexes arrays are spilled to temporary files
+        // and blocks are processed in groups of at most maxGroupIndexesCount reads and suffixes indexes
+        bool spillIndexes = false;
+        uint_reads_cnt_max maxGroupIndexesCount = UINT64_MAX;
 
-        uint_reads_cnt sortedReadsBlockPos[MAX_BLOCKS_COUNT + 1];
-        uint_reads_cnt sortedReadsCount[MAX_BLOCKS_COUNT] = { 0 };
+        uint8_t blockPrefixLength = MIN_BLOCK_PREFIX_LENGTH;
+        uint32_t blocksCount;
 
-        uint_reads_cnt sortedSuffixBlockPlusSymbolPos[MAX_BLOCKS_COUNT + 1][MAX_SYMBOLS_COUNT + 1];
-        uint_reads_cnt sortedSuffixBlockPos[MAX_BLOCKS_COUNT + 1];
+        vector<uint_reads_cnt> sortedReadsBlockPos;
+        vector<uint_reads_cnt> sortedReadsCount;
 
-        uint16_t threadStartBlock[UINT8_MAX] = { 0 };
+        vector<array<uint_reads_cnt, MAX_SYMBOLS_COUNT + 1>> sortedSuffixBlockPlusSymbolPos;
+        vector<uint_reads_cnt> sortedSuffixBlockPos;
 
-        struct PackedReadsComparator {
-            ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>* myGenerator;
-            PackedReadsComparator(ParallelGreedySwipingPackedOverlapGeneratorTemplate<uint_read_len, uint_reads_cnt>* generator) : myGenerator(generator) {};
-
-            bool operator() (uint_reads_cnt lIncIdx, uint_reads_cnt rIncIdx) const {
-                return myGenerator->compareReads(lIncIdx, rIncIdx) < 0;
-            }
-        };
+        uint32_t threadStartBlock[UINT8_MAX + 1] = { 0 };
 
         struct PackedReadVsPatternComparator {
             const uint_reads_cnt PATTERN_INDEX = -1;
@@ -70,12 +70,42 @@ namespace PgSAIndex {
 
         int compareReads(uint_reads_cnt lIncIdx, uint_reads_cnt rIncIdx);
 
+        // open addressing table of identical reads keyed by 128-bit hash of a packed read (verified by full compare);
+        // idx holds the lowest index (representative) and tail the last read of the chain of duplicates
+        struct DuplicatesTableSlot {
+            uint_reads_cnt idx;
+            uint32_t fingerprint;
+            uint_reads_cnt tail;
+        };
+
+        // duplicate (non-representative) read with its table slot
+        struct DuplicateEntry {
+            uint_reads_cnt_max slot;
+            uint_reads_cnt idx;
+
+            bool operator<(const DuplicateEntry &other) const {
+                return slot < other.slot || (slot == other.slot && idx < other.idx);
+            }
+        };
+
+        uint_reads_cnt_max findDuplicatesTableSlot(DuplicatesTableSlot* table, uint_reads_cnt_max slotsMask,
+                uint_reads_cnt incIdx, bool insertMode);
+        template<bool avoidCyclesMode>
+        void collapseDuplicates(vector<uint_reads_cnt> &uniqueReadsIdxs);
+        uint_reads_cnt getDuplicatesTail(uint_reads_cnt incIdx);
+
         uchar getSymbolOrderFromRead(uint_reads_cnt incIdx, uint_read_len offset);
 
-        void updateSuffixQueue(uchar suffixGroup, uint_read_len suffixOffset,
-                uint_reads_cnt* ssiSymbolIdx, uint_reads_cnt* ssiSymbolEnd, deque<uchar> &ssiOrder);
+        // current suffix of a merged group with its cached key (ties are resolved by turn, i.e. in insertion order)
+        struct SuffixGroupHead {
+            uint_reads_cnt pos;
+            uint_reads_cnt end;
+            uint64_t key;
+            uint_reads_cnt turn;
+        };
 
-        int compareSuffixes(uchar lSymOrder, uchar rSymOrder, uint_read_len offset, uint_reads_cnt* ssiSymbolIdx);
+        void updateSuffixGroupHead(SuffixGroupHead &head, uint_read_len suffixOffset, uint_reads_cnt &turn);
+        bool isSuffixGroupHeadFirst(const SuffixGroupHead &l, const SuffixGroupHead &r, uint_read_len suffixOffset);
         int compareSuffixWithPrefix(uint_reads_cnt sufIncIdx, uint_reads_cnt preIncIdx, uint_read_len sufOffset);
 
         virtual uint_read_len readLength(uint_reads_cnt incIdx) override;
@@ -87,17 +117,24 @@ namespace PgSAIndex {
 
         bool isGenerationCyclesAware(bool pgGenerationMode) { return false; };
 
-        template<bool pgGenerationMode>
+        template<bool avoidCyclesMode>
         void initAndFindDuplicates();
-        void prepareSortedReadsBlocks();
+        void radixSortOfReadsIdxs(uint_reads_cnt *idxs, uint_reads_cnt *tmpIdxs, uint_reads_cnt count, uint_read_len_max bytePos);
+        void parallelRadixSortOfReadsIdxs(const vector<uint_reads_cnt> &uniqueReadsIdxs);
+        void findSortedReadsBlocksPositions();
+        uint_reads_cnt maxBlockReadsCount();
+        void prepareSortedReadsBlocks(const vector<uint_reads_cnt> &uniqueReadsIdxs);
+        uint64_t residentBytes();
+        void planIndexesMemory();
+        void findBlocksGroupsEnds(uint32_t curBlocksCount, vector<uint32_t> &groupsEnds);
         void mergeSortOfLeftSuffixes(uint_read_len offset, const uint_reads_cnt *sortedSuffixesLeftCount,
-                uint_reads_cnt *sortedSuffixLeftIdxsPtr, const uint_reads_cnt *sortedSuffixIdxsPtr);
+                SpillableArray<uint_reads_cnt> &sortedSuffixLeftIdxs, const uint_reads_cnt *sortedSuffixIdxsPtr);
 
         template<bool pgGenerationMode>
         void overlapSortedReadsAndSuffixes(uint_read_len suffixesOffset, uint_reads_cnt *sortedSuffixesLeftCount);
         template<bool pgGenerationMode>
         void blockPrefixOverlapSortedReadsAndSuffixesWithAfterSuffixMerge(uint_read_len suffixesOffset,
-                                                                          uint16_t curBlocksCount);
+                                                                          uint32_t curBlocksCount);
 
         void validateSortedSuffixes(uint_read_len offset) const;
 
@@ -18,6 +18,12 @@ namespace PgSAIndex {
                 if (pgh.isPGLengthMax())
                     return readPseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max>(src, pgh);
             }
+            if (pgh.isReadsCountMax()) {
+                if (pgh.isPGLengthStd())
+                    return readPseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std>(src, pgh);
+                if (pgh.isPGLengthMax())
+                    return readPseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max>(src, pgh);
+            }
         }
         if (pgh.isReadLengthStd()) {
             if (pgh.isReadsCountStd()) {
@@ -26,6 +32,12 @@ namespace PgSAIndex {
                 if (pgh.isPGLengthMax())
                     return readPseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max>(src, pgh);
             }
+            if (pgh.isReadsCountMax()) {
+                if (pgh.isPGLengthStd())
+                    return readPseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std>(src, pgh);
+                if (pgh.isPGLengthMax())
+                    return readPseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max>(src, pgh);
+            }
         }
 
         cout << "ERROR: CANNOT DETERMINE TEMPLATE TYPES";
@@ -106,5 +118,9 @@ namespace PgSAIndex {
     template PseudoGenomeBase* PseudoGenomePersistence::readPseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max>(std::istream& src, PseudoGenomeHeader& pgh);
     template PseudoGenomeBase* PseudoGenomePersistence::readPseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_std>(std::istream& src, PseudoGenomeHeader& pgh);
     template PseudoGenomeBase* PseudoGenomePersistence::readPseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max>(std::istream& src, PseudoGenomeHeader& pgh);
+    template PseudoGenomeBase* PseudoGenomePersistence::readPseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std>(std::istream& src, PseudoGenomeHeader& pgh);
+    template PseudoGenomeBase* PseudoGenomePersistence::readPseudoGenomeTemplate<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max>(std::istream& src, PseudoGenomeHeader& pgh);
+    template PseudoGenomeBase* PseudoGenomePersistence::readPseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std>(std::istream& src, PseudoGenomeHeader& pgh);
+    template PseudoGenomeBase* PseudoGenomePersistence::readPseudoGenomeTemplate<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max>(std::istream& src, PseudoGenomeHeader& pgh);
     
 }
@@ -150,45 +150,51 @@ namespace PgTools {
     bool SeparatedPseudoGenomePersistence::enableReadPositionRepresentation = false;
     bool SeparatedPseudoGenomePersistence::enableRevOffsetMismatchesRepresentation = true;
 
-    void SeparatedPseudoGenomePersistence::appendIndexesFromPg(string pgFilePrefix, vector<uint_reads_cnt_std> &idxs) {
+    void SeparatedPseudoGenomePersistence::appendIndexesFromPg(string pgFilePrefix, ReadsIndexesVector &idxs) {
         bool plainTextReadMode;
         PseudoGenomeHeader* pgh;
         ReadsSetProperties* rsProp;
         SeparatedPseudoGenomeBase::getPseudoGenomeProperties(pgFilePrefix, pgh, rsProp, plainTextReadMode);
         ifstream orgIdxsSrc = getPseudoGenomeElementSrc(pgFilePrefix, SeparatedPseudoGenomeBase::READSLIST_ORIGINAL_INDEXES_FILE_SUFFIX);
         const uint_reads_cnt_max readsCount = pgh->getReadsCount();
+        const uchar orgIdxBytes = SeparatedPseudoGenomeBase::getOriginalIndexBytes(orgIdxsSrc, readsCount);
         idxs.reserve(idxs.size() + readsCount);
-        for(uint_reads_cnt_std i = 0; i < readsCount; i++) {
-            uint_reads_cnt_std idx;
-            readValue<uint_reads_cnt_std>(orgIdxsSrc, idx, plainTextReadMode);
-            idxs.push_back(idx);
-        }
+        for(uint_reads_cnt_max i = 0; i < readsCount; i++)
+            idxs.push_back(SeparatedPseudoGenomeBase::readOriginalIndex(orgIdxsSrc, orgIdxBytes, plainTextReadMode));
         delete(pgh);
         delete(rsProp);
     }
 
     void SeparatedPseudoGenomePersistence::writePairMapping(string &pgFilePrefix,
-                                                            vector<uint_reads_cnt_std> orgIdxs) {
+                                                            const ReadsIndexesVector &orgIdxs) {
         ofstream pair1OffsetsDest = getPseudoGenomeElementDest(pgFilePrefix, SeparatedPseudoGenomeBase::READSLIST_PAIR_FIRST_OFFSETS_FILE_SUFFIX, true);
         ofstream pair1SrcFlagDest = getPseudoGenomeElementDest(pgFilePrefix, SeparatedPseudoGenomeBase::READSLIST_PAIR_FIRST_SOURCE_FLAG_FILE_SUFFIX, true);
         ofstream pair1IndexesDest = getPseudoGenomeElementDest(pgFilePrefix, SeparatedPseudoGenomeBase::READSLIST_PAIR_FIRST_INDEXES_FILE_SUFFIX, true);
         writeReadMode(pair1OffsetsDest, PgSAHelpers::plainTextWriteMode);
         writeReadMode(pair1IndexesDest, PgSAHelpers::plainTextWriteMode);
-        uint_reads_cnt_std readsCount = orgIdxs.size();
-        vector<uint_reads_cnt_std> rev(readsCount);
-        for(uint_reads_cnt_std i = 0; i < readsCount; i++)
-            rev[orgIdxs[i]] = i;
+        uint_reads_cnt_max readsCount = orgIdxs.size();
+        ReadsIndexesVector rev(readsCount);
+        rev.resize(readsCount);
+        for(uint_reads_cnt_max i = 0; i < readsCount; i++)
+            rev.set(orgIdxs[i], i);
         vector<bool> isReadDone(readsCount, false);
-        for(uint32_t i = 0; i < readsCount; i++) {
+        for(uint_reads_cnt_max i = 0; i < readsCount; i++) {
             if (isReadDone[i])
                 continue;
-            uint_reads_cnt_std idx = orgIdxs[i];
-            uint_reads_cnt_std pairIdx = idx % 2?(idx-1):(idx+1);
-            uint_reads_cnt_std pairI = rev[pairIdx];
+            uint_reads_cnt_max idx = orgIdxs[i];
+            uint_reads_cnt_max pairIdx = idx % 2?(idx-1):(idx+1);
+            uint_reads_cnt_max pairI = rev[pairIdx];
             isReadDone[pairI] = true;
-            writeValue<uint_reads_cnt_std>(pair1OffsetsDest, pairI > i?pairI - i: readsCount - (i - pairI));
-            writeValue<uint8_t>(pair1SrcFlagDest, idx % 2);
-            writeValue<uint_reads_cnt_std>(pair1IndexesDest, idx);
+            const uint_reads_cnt_max pairOffset = pairI > i?pairI - i: readsCount - (i - pairI);
+            if (rev.isNarrow()) {
+                writeValue<uint_reads_cnt_std>(pair1OffsetsDest, pairOffset);
+                writeValue<uint8_t>(pair1SrcFlagDest, idx % 2);
+                writeValue<uint_reads_cnt_std>(pair1IndexesDest, idx);
+            } else {
+                writeValue<uint_reads_cnt_max>(pair1OffsetsDest, pairOffset);
+                writeValue<uint8_t>(pair1SrcFlagDest, idx % 2);
+                writeValue<uint_reads_cnt_max>(pair1IndexesDest, idx);
+            }
         }
         pair1IndexesDest.close();
         pair1OffsetsDest.close();
@@ -197,7 +203,7 @@ namespace PgTools {
 
     void SeparatedPseudoGenomePersistence::dumpPgPairs(vector<string> pgFilePrefixes) {
         time_checkpoint();
-        vector<uint_reads_cnt_std> orgIdxs;
+        ReadsIndexesVector orgIdxs;
         for(string pgFilePrefix: pgFilePrefixes)
             SeparatedPseudoGenomePersistence::appendIndexesFromPg(pgFilePrefix, orgIdxs);
 
@@ -206,21 +212,33 @@ namespace PgTools {
     }
 
     void SeparatedPseudoGenomePersistence::compressReadsOrder(ostream &pgrcOut,
-            const vector<uint_reads_cnt_std>& orgIdxs, uint8_t coder_level,
+            const ReadsIndexesVector& orgIdxs, uint8_t coder_level,
+            bool completeOrderInfo, bool ignorePairOrderInformation, bool singleFileMode) {
+        if (orgIdxs.isNarrow())
+            compressReadsOrderTemplate<uint_reads_cnt_std>(pgrcOut, orgIdxs.getNarrowVector(), coder_level,
+                    completeOrderInfo, ignorePairOrderInformation, singleFileMode);
+        else
+            compressReadsOrderTemplate<uint_reads_cnt_max>(pgrcOut, orgIdxs.getWideVector(), coder_level,
+                    completeOrderInfo, ignorePairOrderInformation, singleFileMode);
+    }
+
+    template <typename uint_reads_cnt>
+    void SeparatedPseudoGenomePersistence::compressReadsOrderTemplate(ostream &pgrcOut,
+            const vector<uint_reads_cnt>& orgIdxs, uint8_t coder_level,
             bool completeOrderInfo, bool ignorePairOrderInformation, bool singleFileMode) {
         time_checkpoint();
-        uint_reads_cnt_std readsCount = orgIdxs.size();
-        int lzma_reads_dataperiod_param = readsCount <= UINT32_MAX ? PGRC_DATAPERIODCODE_32_t : PGRC_DATAPERIODCODE_64_t;
-        vector<uint_reads_cnt_std> rev(readsCount);
-        for (uint_reads_cnt_std i = 0; i < readsCount; i++)
+        uint_reads_cnt readsCount = orgIdxs.size();
+        int lzma_reads_dataperiod_param = sizeof(uint_reads_cnt) == 4 ? PGRC_DATAPERIODCODE_32_t : PGRC_DATAPERIODCODE_64_t;
+        vector<uint_reads_cnt> rev(readsCount);
+        for (uint_reads_cnt i = 0; i < readsCount; i++)
             rev[orgIdxs[i]] = i;
         if (completeOrderInfo && singleFileMode) {
             *logout << "Reverse index of original indexes... ";
-            writeCompressed(pgrcOut, (char *) rev.data(), rev.size() * sizeof(uint_reads_cnt_std), LZMA_CODER,
+            writeCompressed(pgrcOut, (char *) rev.data(), rev.size() * sizeof(uint_reads_cnt), LZMA_CODER,
                     coder_level, lzma_reads_dataperiod_param);
         } else {
             // absolute pair base index of original pair
-            vector<uint_reads_cnt_std> revPairBaseOrgIdx;
+            vector<uint_reads_cnt> revPairBaseOrgIdx;
             if (completeOrderInfo)
                 revPairBaseOrgIdx.resize(readsCount / 2);
             // flag indicating a processed pair base file (0 - Second, 1 - First)
@@ -240,19 +258,19 @@ namespace PgTools {
             deltaInInt8Flag.reserve(readsCount / 4); // estimated
             vector<int8_t> deltaInInt8Value;
             deltaInInt8Value.reserve(readsCount / 16); // estimated
-            vector<uint_reads_cnt_std> fullOffset;
+            vector<uint_reads_cnt> fullOffset;
             deltaInInt8Value.reserve(readsCount / 8); // estimated
 
             vector<bool> isReadDone(readsCount, false);
             int64_t refPrev = 0;
             int64_t prev = 0;
             bool match = false;
-            for (uint32_t i1 = 0; i1 < readsCount; i1++) {
+            for (uint_reads_cnt i1 = 0; i1 < readsCount; i1++) {
                 if (isReadDone[i1])
                     continue;
-                uint_reads_cnt_std orgIdx = orgIdxs[i1];
-                uint_reads_cnt_std pairOrgIdx = orgIdx % 2 ? (orgIdx - 1) : (orgIdx + 1);
-                uint_reads_cnt_std i2 = rev[pairOrgIdx]; // i2 > i1
+                uint_reads_cnt orgIdx = orgIdxs[i1];
+                uint_reads_cnt pairOrgIdx = orgIdx % 2 ? (orgIdx - 1) : (orgIdx + 1);
+                uint_reads_cnt i2 = rev[pairOrgIdx]; // i2 > i1
                 isReadDone[i2] = true;
                 if (completeOrderInfo)
                     revPairBaseOrgIdx[orgIdx / 2] = offsetInUint8Flag.size() * 2 + orgIdx % 2;
@@ -296,12 +314,12 @@ namespace PgTools {
                             LZMA_CODER, coder_level, PGRC_DATAPERIODCODE_8_t);
 //            writeCompressed(pgrcOut, (char *) deltaInInt8Value.data(), deltaInInt8Value.size() * sizeof(int8_t), PPMD7_CODER, coder_level, 2);
             *logout << "Full reads list relative offsets of pair reads ... ";
-            double estimated_reads_ratio = simpleUintCompressionEstimate(readsCount, readsCount <= UINT32_MAX?UINT32_MAX:UINT64_MAX);
-            writeCompressed(pgrcOut, (char *) fullOffset.data(), fullOffset.size() * sizeof(uint_reads_cnt_std),
+            double estimated_reads_ratio = simpleUintCompressionEstimate(readsCount, sizeof(uint_reads_cnt) == 4?UINT32_MAX:UINT64_MAX);
+            writeCompressed(pgrcOut, (char *) fullOffset.data(), fullOffset.size() * sizeof(uint_reads_cnt),
                             LZMA_CODER, coder_level, lzma_reads_dataperiod_param, estimated_reads_ratio);
             if (completeOrderInfo) {
                 *logout << "Original indexes of pair bases... ";
-                writeCompressed(pgrcOut, (char *) revPairBaseOrgIdx.data(), revPairBaseOrgIdx.size() * sizeof(uint_reads_cnt_std),
+                writeCompressed(pgrcOut, (char *) revPairBaseOrgIdx.data(), revPairBaseOrgIdx.size() * sizeof(uint_reads_cnt),
                                 LZMA_CODER, coder_level, lzma_reads_dataperiod_param, estimated_reads_ratio);
             } else if (!ignorePairOrderInformation) {
                 *logout << "File flags of pair bases (for offsets)... ";
@@ -317,26 +335,39 @@ namespace PgTools {
     }
 
     void SeparatedPseudoGenomePersistence::decompressReadsOrder(istream &pgrcIn,
-                                                                vector<uint_reads_cnt_std> &rlIdxOrder,
+                                                                ReadsIndexesVector &rlIdxOrder,
+                                                                bool completeOrderInfo, bool ignorePairOrderInformation,
+                                                                bool singleFileMode) {
+        if (rlIdxOrder.isNarrow())
+            decompressReadsOrderTemplate<uint_reads_cnt_std>(pgrcIn, rlIdxOrder.getNarrowVector(),
+                    completeOrderInfo, ignorePairOrderInformation, singleFileMode);
+        else
+            decompressReadsOrderTemplate<uint_reads_cnt_max>(pgrcIn, rlIdxOrder.getWideVector(),
+                    completeOrderInfo, ignorePairOrderInformation, singleFileMode);
+    }
+
+    template <typename uint_reads_cnt>
+    void SeparatedPseudoGenomePersistence::decompressReadsOrderTemplate(istream &pgrcIn,
+                                                                vector<uint_reads_cnt> &rlIdxOrder,
                                                                 bool completeOrderInfo, bool ignorePairOrderInformation,
                                                                 bool singleFileMode) {
         if (singleFileMode) {
             if (!completeOrderInfo)
                 return;
-            readCompressed<uint_reads_cnt_std>(pgrcIn, rlIdxOrder);
+            readCompressed<uint_reads_cnt>(pgrcIn, rlIdxOrder);
         } else {
             vector<uint8_t> offsetInUint8Flag;
             vector<uint8_t> offsetInUint8Value;
             vector<uint8_t> deltaInInt8Flag;
             vector<int8_t> deltaInInt8Value;
-            vector<uint_reads_cnt_std> fullOffset;
+            vector<uint_reads_cnt> fullOffset;
             readCompressed<uint8_t>(pgrcIn, offsetInUint8Flag);
             readCompressed<uint8_t>(pgrcIn, offsetInUint8Value);
             readCompressed<uint8_t>(pgrcIn, deltaInInt8Flag);
             readCompressed<int8_t>(pgrcIn, deltaInInt8Value);
-            readCompressed<uint_reads_cnt_std>(pgrcIn, fullOffset);
+            readCompressed<uint_reads_cnt>(pgrcIn, fullOffset);
 
-            uint_reads_cnt_std readsCount = offsetInUint8Flag.size() * 2;
+            uint_reads_cnt readsCount = offsetInUint8Flag.size() * 2;
             rlIdxOrder.resize(readsCount);
             vector<bool> isReadDone(readsCount, false);
             int64_t pairOffset = 0;
@@ -349,7 +380,7 @@ namespace PgTools {
             int64_t prev = 0;
             bool match = false;
 
-            for(uint_reads_cnt_std i = 0; i < readsCount; i++) {
+            for(uint_reads_cnt i = 0; i < readsCount; i++) {
                 if (isReadDone[i])
                     continue;
                 if (offsetInUint8Flag[++pairCounter])
@@ -371,13 +402,13 @@ namespace PgTools {
                 isReadDone[i + pairOffset] = true;
             }
             if (completeOrderInfo) {
-                vector<uint_reads_cnt_std> revPairBaseOrgIdx;
+                vector<uint_reads_cnt> revPairBaseOrgIdx;
                 revPairBaseOrgIdx.reserve(readsCount);
-                readCompressed<uint_reads_cnt_std>(pgrcIn, revPairBaseOrgIdx);
+                readCompressed<uint_reads_cnt>(pgrcIn, revPairBaseOrgIdx);
                 revPairBaseOrgIdx.resize(readsCount);
-                vector<uint_reads_cnt_std> peRlIdxOrder = std::move(rlIdxOrder);
-                for(uint_reads_cnt_std p = readsCount / 2; p-- > 0;) {
-                    uint_reads_cnt_std rlIdx = revPairBaseOrgIdx[p];
+                vector<uint_reads_cnt> peRlIdxOrder = std::move(rlIdxOrder);
+                for(uint_reads_cnt p = readsCount / 2; p-- > 0;) {
+                    uint_reads_cnt rlIdx = revPairBaseOrgIdx[p];
                     revPairBaseOrgIdx[p * 2] = peRlIdxOrder[rlIdx];
                     revPairBaseOrgIdx[p * 2 + 1] = peRlIdxOrder[rlIdx % 2?rlIdx - 1:rlIdx + 1];
                 }
@@ -389,10 +420,10 @@ namespace PgTools {
                 readCompressed<uint8_t>(pgrcIn, nonOffsetPairBaseFileFlag);
                 int64_t offIdx = -1;
                 int64_t nonOffIdx = -1;
-                for(uint_reads_cnt_std p = 0; p < readsCount / 2; p++) {
+                for(uint_reads_cnt p = 0; p < readsCount / 2; p++) {
                     bool swapPair = offsetInUint8Flag[p]?offsetPairBaseFileFlag[++offIdx]:nonOffsetPairBaseFileFlag[++nonOffIdx];
                     if (swapPair) {
-                        uint_reads_cnt_std tmpIdx = rlIdxOrder[p * 2];
+                        uint_reads_cnt tmpIdx = rlIdxOrder[p * 2];
                         rlIdxOrder[p * 2] = rlIdxOrder[p * 2 + 1];
                         rlIdxOrder[p * 2 + 1] = tmpIdx;
                     }
@@ -401,120 +432,131 @@ namespace PgTools {
         }
     }
 
+    template <typename uint_pg_len, typename uint_reads_cnt>
+    void SeparatedPseudoGenomePersistence::compressPairedReadsPgPositions(ostream &pgrcOut,
+            const vector<uint_pg_len_max> &orgIdx2PgPos, uint8_t coder_level, bool deltaPairEncodingEnabled,
+            int lzma_pos_dataperiod_param, double estimated_pos_ratio) {
+        vector<uint_pg_len> basePairPos;
+        // pair relative offset info
+        vector<uint8_t> offsetInUint16Flag;
+        vector<uint8_t> offsetIsBaseFirstFlag;
+        vector<uint16_t> offsetInUint16Value;
+        vector<uint8_t> deltaInInt16Flag;
+        vector<uint8_t> deltaIsBaseFirstFlag;
+        vector<int16_t> deltaInInt16Value;
+        vector<uint_pg_len> notBasePairPos;
+        const uint_reads_cnt readsTotalCount = orgIdx2PgPos.size();
+        const uint_reads_cnt pairsCount = readsTotalCount / 2;
+        basePairPos.reserve(pairsCount);
+        offsetInUint16Flag.reserve(pairsCount);
+        offsetIsBaseFirstFlag.reserve(pairsCount);
+        offsetInUint16Value.reserve(pairsCount);
+        if (deltaPairEncodingEnabled) {
+            deltaInInt16Flag.reserve(pairsCount / 2);
+            deltaIsBaseFirstFlag.reserve(pairsCount / 8);
+            deltaInInt16Value.reserve(pairsCount / 8);
+        }
+        notBasePairPos.reserve(pairsCount / 4);
+
+        vector<uint_reads_cnt> bppRank;
+        bppRank.reserve(pairsCount);
+        for (uint_reads_cnt i = 0; i < readsTotalCount; i += 2) {
+            basePairPos.push_back(orgIdx2PgPos[i]);
+            bppRank.push_back(i >> 1);
+        }
+        __gnu_parallel::stable_sort(bppRank.begin(), bppRank.end(),
+                [&](const uint_reads_cnt &idx1, const uint_reads_cnt &idx2) -> bool
+                    { return basePairPos[idx1] < basePairPos[idx2]; });
+        *logout << "... reordering bases checkpoint: " << time_millis() << " msec. " << endl;
+        int64_t refPrev = 0;
+        int64_t prev = 0;
+        bool match = false;
+        for (uint_reads_cnt p = 0; p < pairsCount; p++) {
+            uint_reads_cnt i = bppRank[p] * 2;
+
+            bool isBaseBefore = orgIdx2PgPos[i] < orgIdx2PgPos[i + 1];
+            uint_pg_len relativeAbsOffset = isBaseBefore?(orgIdx2PgPos[i + 1] - orgIdx2PgPos[i]):
+                                orgIdx2PgPos[i] - orgIdx2PgPos[i + 1];
+            const bool isOffsetInUint16 = relativeAbsOffset <= UINT16_MAX;
+            offsetInUint16Flag.push_back(isOffsetInUint16 ? 1 : 0);
+            if (isOffsetInUint16) {
+                offsetIsBaseFirstFlag.push_back(isBaseBefore?1:0);
+                offsetInUint16Value.push_back((uint16_t) relativeAbsOffset);
+                continue;
+            }
+            if (deltaPairEncodingEnabled) {
+                const int64_t delta = relativeAbsOffset - refPrev;
+                const bool isDeltaInInt16 = delta <= INT16_MAX && delta >= INT16_MIN;
+                deltaInInt16Flag.push_back((uint8_t) isDeltaInInt16);
+                if (isDeltaInInt16) {
+                    match = true;
+                    deltaIsBaseFirstFlag.push_back(isBaseBefore ? 1 : 0);
+                    deltaInInt16Value.push_back((int16_t) delta);
+                    refPrev = relativeAbsOffset;
+                } else {
+                    if (!match || refPrev != prev)
+                        refPrev = relativeAbsOffset;
+                    notBasePairPos.push_back((uint_pg_len) orgIdx2PgPos[i + 1]);
+                    match = false;
+                }
+                prev = relativeAbsOffset;
+            } else {
+                notBasePairPos.push_back((uint_pg_len) orgIdx2PgPos[i + 1]);
+            }
+        }
+        pgrcOut.put(deltaPairEncodingEnabled);
+        *logout << "Base pair position... ";
+        writeCompressed(pgrcOut, (char *) basePairPos.data(), basePairPos.size() * sizeof(uint_pg_len),
+                        LZMA_CODER, coder_level, lzma_pos_dataperiod_param, estimated_pos_ratio);
+        *logout << "Uint16 relative offset of pair positions (flag)... ";
+        writeCompressed(pgrcOut, (char *) offsetInUint16Flag.data(), offsetInUint16Flag.size() * sizeof(uint8_t),
+                        PPMD7_CODER, coder_level, 3, COMPRESSION_ESTIMATION_UINT8_BITMAP);
+        *logout << "Is uint16 relative offset of pair positions positive (flag)... ";
+        writeCompressed(pgrcOut, (char *) offsetIsBaseFirstFlag.data(), offsetIsBaseFirstFlag.size() * sizeof(uint8_t),
+                        PPMD7_CODER, coder_level, 3, COMPRESSION_ESTIMATION_UINT8_BITMAP);
+        *logout << "Uint16 relative offset of pair positions (value)... ";
+        writeCompressed(pgrcOut, (char*) offsetInUint16Value.data(), offsetInUint16Value.size() * sizeof(uint16_t),
+                        PPMD7_CODER, coder_level, 3);
+        if (deltaPairEncodingEnabled) {
+            *logout << "Relative offset deltas of pair positions (flag)... ";
+            writeCompressed(pgrcOut, (char *) deltaInInt16Flag.data(), deltaInInt16Flag.size() * sizeof(uint8_t),
+                            PPMD7_CODER, coder_level, 3, COMPRESSION_ESTIMATION_UINT8_BITMAP);
+            *logout << "Is relative offset (for deltas stream) of pair positions positive (flag)... ";
+            writeCompressed(pgrcOut, (char *) deltaIsBaseFirstFlag.data(),
+                            deltaIsBaseFirstFlag.size() * sizeof(uint8_t),
+                            PPMD7_CODER, coder_level, 3, COMPRESSION_ESTIMATION_UINT8_BITMAP);
+            *logout << "Relative offset deltas of pair positions (value)... ";
+            writeCompressed(pgrcOut, (char *) deltaInInt16Value.data(), deltaInInt16Value.size() * sizeof(int16_t),
+                            PPMD7_CODER, coder_level, 3);
+        }
+        *logout << "Not-base pair position... ";
+        writeCompressed(pgrcOut, (char *) notBasePairPos.data(), notBasePairPos.size() * sizeof(uint_pg_len),
+                        LZMA_CODER, coder_level, lzma_pos_dataperiod_param, estimated_pos_ratio);
+    }
+
     template <typename uint_pg_len>
     void SeparatedPseudoGenomePersistence::compressReadsPgPositions(ostream &pgrcOut,
             vector<uint_pg_len_max> orgIdx2PgPos, uint_pg_len_max joinedPgLength, uint8_t coder_level,
             bool singleFileMode, bool deltaPairEncodingEnabled) {
         time_checkpoint();
-        uint_reads_cnt_std readsTotalCount = orgIdx2PgPos.size();
+        uint_reads_cnt_max readsTotalCount = orgIdx2PgPos.size();
         int lzma_pos_dataperiod_param = sizeof(uint_pg_len) == 4 ? PGRC_DATAPERIODCODE_32_t : PGRC_DATAPERIODCODE_64_t;
         double estimated_pos_ratio = simpleUintCompressionEstimate(joinedPgLength, sizeof(uint_pg_len) == 4?UINT32_MAX:UINT64_MAX);
         if (singleFileMode) {
             uint_pg_len_max* const maxPgPosPtr = orgIdx2PgPos.data();
             if (sizeof(uint_pg_len) < sizeof(uint_pg_len_max)) {
                 uint_pg_len* PgPosPtr = (uint_pg_len*) maxPgPosPtr;
-                for (uint_reads_cnt_std i = 0; i < readsTotalCount; i++)
+                for (uint_reads_cnt_max i = 0; i < readsTotalCount; i++)
                     *(PgPosPtr++) = (uint_pg_len) orgIdx2PgPos[i];
             }
             writeCompressed(pgrcOut, (char*) maxPgPosPtr, readsTotalCount * sizeof(uint_pg_len),
                             LZMA_CODER, coder_level, lzma_pos_dataperiod_param, estimated_pos_ratio);
-        } else {
-            vector<uint_pg_len> basePairPos;
-            // pair relative offset info
-            vector<uint8_t> offsetInUint16Flag;
-            vector<uint8_t> offsetIsBaseFirstFlag;
-            vector<uint16_t> offsetInUint16Value;
-            vector<uint8_t> deltaInInt16Flag;
-            vector<uint8_t> deltaIsBaseFirstFlag;
-            vector<int16_t> deltaInInt16Value;
-            vector<uint_pg_len> notBasePairPos;
-            const uint_reads_cnt_std pairsCount = readsTotalCount / 2;
-            basePairPos.reserve(pairsCount);
-            offsetInUint16Flag.reserve(pairsCount);
-            offsetIsBaseFirstFlag.reserve(pairsCount);
-            offsetInUint16Value.reserve(pairsCount);
-            if (deltaPairEncodingEnabled) {
-                deltaInInt16Flag.reserve(pairsCount / 2);
-                deltaIsBaseFirstFlag.reserve(pairsCount / 8);
-                deltaInInt16Value.reserve(pairsCount / 8);
-            }
-            notBasePairPos.reserve(pairsCount / 4);
-
-            vector<uint_reads_cnt_std> bppRank;
-            bppRank.reserve(pairsCount);
-            for (uint_reads_cnt_std i = 0; i < readsTotalCount; i += 2) {
-                basePairPos.push_back(orgIdx2PgPos[i]);
-                bppRank.push_back(i >> 1);
-            }
-            __gnu_parallel::stable_sort(bppRank.begin(), bppRank.end(),
-                    [&](const uint_reads_cnt_std &idx1, const uint_reads_cnt_std &idx2) -> bool
-                        { return basePairPos[idx1] < basePairPos[idx2]; });
-            *logout << "... reordering bases checkpoint: " << time_millis() << " msec. " << endl;
-            int64_t refPrev = 0;
-            int64_t prev = 0;
-            bool match = false;
-            for (uint_reads_cnt_std p = 0; p < pairsCount; p++) {
-                uint_reads_cnt_std i = bppRank[p] * 2;
-
-                bool isBaseBefore = orgIdx2PgPos[i] < orgIdx2PgPos[i + 1];
-                uint_pg_len relativeAbsOffset = isBaseBefore?(orgIdx2PgPos[i + 1] - orgIdx2PgPos[i]):
-                                    orgIdx2PgPos[i] - orgIdx2PgPos[i + 1];
-                const bool isOffsetInUint16 = relativeAbsOffset <= UINT16_MAX;
-                offsetInUint16Flag.push_back(isOffsetInUint16 ? 1 : 0);
-                if (isOffsetInUint16) {
-                    offsetIsBaseFirstFlag.push_back(isBaseBefore?1:0);
-                    offsetInUint16Value.push_back((uint16_t) relativeAbsOffset);
-                    continue;
-                }
-                if (deltaPairEncodingEnabled) {
-                    const int64_t delta = relativeAbsOffset - refPrev;
-                    const bool isDeltaInInt16 = delta <= INT16_MAX && delta >= INT16_MIN;
-                    deltaInInt16Flag.push_back((uint8_t) isDeltaInInt16);
-                    if (isDeltaInInt16) {
-                        match = true;
-                        deltaIsBaseFirstFlag.push_back(isBaseBefore ? 1 : 0);
-                        deltaInInt16Value.push_back((int16_t) delta);
-                        refPrev = relativeAbsOffset;
-                    } else {
-                        if (!match || refPrev != prev)
-                            refPrev = relativeAbsOffset;
-                        notBasePairPos.push_back((uint_pg_len) orgIdx2PgPos[i + 1]);
-                        match = false;
-                    }
-                    prev = relativeAbsOffset;
-                } else {
-                    notBasePairPos.push_back((uint_pg_len) orgIdx2PgPos[i + 1]);
-                }
-            }
-            pgrcOut.put(deltaPairEncodingEnabled);
-            *logout << "Base pair position... ";
-            writeCompressed(pgrcOut, (char *) basePairPos.data(), basePairPos.size() * sizeof(uint_pg_len),
-                            LZMA_CODER, coder_level, lzma_pos_dataperiod_param, estimated_pos_ratio);
-            *logout << "Uint16 relative offset of pair positions (flag)... ";
-            writeCompressed(pgrcOut, (char *) offsetInUint16Flag.data(), offsetInUint16Flag.size() * sizeof(uint8_t),
-                            PPMD7_CODER, coder_level, 3, COMPRESSION_ESTIMATION_UINT8_BITMAP);
-            *logout << "Is uint16 relative offset of pair positions positive (flag)... ";
-            writeCompressed(pgrcOut, (char *) offsetIsBaseFirstFlag.data(), offsetIsBaseFirstFlag.size() * sizeof(uint8_t),
-                            PPMD7_CODER, coder_level, 3, COMPRESSION_ESTIMATION_UINT8_BITMAP);
-            *logout << "Uint16 relative offset of pair positions (value)... ";
-            writeCompressed(pgrcOut, (char*) offsetInUint16Value.data(), offsetInUint16Value.size() * sizeof(uint16_t),
-                            PPMD7_CODER, coder_level, 3);
-            if (deltaPairEncodingEnabled) {
-                *logout << "Relative offset deltas of pair positions (flag)... ";
-                writeCompressed(pgrcOut, (char *) deltaInInt16Flag.data(), deltaInInt16Flag.size() * sizeof(uint8_t),
-                                PPMD7_CODER, coder_level, 3, COMPRESSION_ESTIMATION_UINT8_BITMAP);
-                *logout << "Is relative offset (for deltas stream) of pair positions positive (flag)... ";
-                writeCompressed(pgrcOut, (char *) deltaIsBaseFirstFlag.data(),
-                                deltaIsBaseFirstFlag.size() * sizeof(uint8_t),
-                                PPMD7_CODER, coder_level, 3, COMPRESSION_ESTIMATION_UINT8_BITMAP);
-                *logout << "Relative offset deltas of pair positions (value)... ";
-                writeCompressed(pgrcOut, (char *) deltaInInt16Value.data(), deltaInInt16Value.size() * sizeof(int16_t),
-                                PPMD7_CODER, coder_level, 3);
-            }
-            *logout << "Not-base pair position... ";
-            writeCompressed(pgrcOut, (char *) notBasePairPos.data(), notBasePairPos.size() * sizeof(uint_pg_len),
-                            LZMA_CODER, coder_level, lzma_pos_dataperiod_param, estimated_pos_ratio);
-        }
+        } else if (isReadsCountStd(readsTotalCount))
+            compressPairedReadsPgPositions<uint_pg_len, uint_reads_cnt_std>(pgrcOut, orgIdx2PgPos, coder_level,
+                    deltaPairEncodingEnabled, lzma_pos_dataperiod_param, estimated_pos_ratio);
+        else
+            compressPairedReadsPgPositions<uint_pg_len, uint_reads_cnt_max>(pgrcOut, orgIdx2PgPos, coder_level,
+                    deltaPairEncodingEnabled, lzma_pos_dataperiod_param, estimated_pos_ratio);
         *logout << "... compressing reads positions completed in " << time_millis() << " msec. " << endl;
         *logout << endl;
     }
@@ -525,80 +567,87 @@ namespace PgTools {
             vector<uint_pg_len_max> orgIdx2PgPos, uint_pg_len_max joinedPgLength, uint8_t coder_level,
             bool singleFileMode, bool deltaPairEncodingEnabled);
 
+    template <typename uint_pg_len, typename uint_reads_cnt>
+    void SeparatedPseudoGenomePersistence::decompressPairedReadsPgPositions(istream &pgrcIn, vector<uint_pg_len> &pgPos,
+                                                                            uint_reads_cnt_max readsTotalCount) {
+        bool deltaPairEncodingEnabled = (bool) pgrcIn.get();
+        vector<uint8_t> offsetInUint16Flag;
+        vector<uint8_t> offsetIsBaseFirstFlag;
+        vector<uint16_t> offsetInUint16Value;
+        vector<uint8_t> deltaInInt16Flag;
+        vector<uint8_t> deltaIsBaseFirstFlag;
+        vector<int16_t> deltaInInt16Value;
+        vector<uint_pg_len> notBasePairPos;
+        pgPos.reserve(readsTotalCount);
+        readCompressed(pgrcIn, pgPos);
+        readCompressed(pgrcIn, offsetInUint16Flag);
+        readCompressed(pgrcIn, offsetIsBaseFirstFlag);
+        readCompressed(pgrcIn, offsetInUint16Value);
+        if (deltaPairEncodingEnabled) {
+            readCompressed(pgrcIn, deltaInInt16Flag);
+            readCompressed(pgrcIn, deltaIsBaseFirstFlag);
+            readCompressed(pgrcIn, deltaInInt16Value);
+        }
+        readCompressed(pgrcIn, notBasePairPos);
+        const uint_reads_cnt pairsCount = readsTotalCount / 2;
+        vector<uint_reads_cnt> bppRank;
+        bppRank.reserve(pairsCount);
+        for (uint_reads_cnt p = 0; p < pairsCount; p++)
+            bppRank.push_back(p);
+        __gnu_parallel::stable_sort(bppRank.begin(), bppRank.end(),
+                         [&](const uint_reads_cnt &idx1, const uint_reads_cnt &idx2) -> bool
+                         { return pgPos[idx1] < pgPos[idx2]; });
+
+        pgPos.resize(readsTotalCount);
+        int64_t nbpPos = 0;
+        int64_t offIdx = -1;
+        int64_t delFlagIdx = -1;
+        int64_t delIdx = -1;
+        int64_t nbpPosIdx = -1;
+        int64_t refPrev = 0;
+        int64_t prev = 0;
+        bool match = false;
+        for (uint_reads_cnt i = 0; i < pairsCount; i++) {
+            uint_reads_cnt p = bppRank[i];
+            if (offsetInUint16Flag[i] == 1) {
+                int64_t delta = offsetInUint16Value[++offIdx];
+                if (offsetIsBaseFirstFlag[offIdx] == 0)
+                    delta = -delta;
+                nbpPos = pgPos[p] + delta;
+            } else if (deltaInInt16Flag[++delFlagIdx]){
+                int64_t delta = refPrev + deltaInInt16Value[++delIdx];
+                refPrev = delta;
+                prev = delta;
+                if (deltaIsBaseFirstFlag[delIdx] == 0)
+                    delta = -delta;
+                nbpPos = pgPos[p] + delta;
+                match = true;
+            } else {
+                nbpPos = notBasePairPos[++nbpPosIdx];
+                int64_t delta = nbpPos - pgPos[p];
+                if (delta < 0)
+                    delta = -delta;
+                if (!match || refPrev != prev)
+                    refPrev = delta;
+                match = false;
+                prev = delta;
+            }
+            pgPos[pairsCount + p] = nbpPos;
+        }
+    }
+
     template <typename uint_pg_len>
     void SeparatedPseudoGenomePersistence::decompressReadsPgPositions(istream &pgrcIn, vector<uint_pg_len> &pgPos,
-                                                                          uint_reads_cnt_std readsTotalCount, bool singleFileMode) {
+                                                                          uint_reads_cnt_max readsTotalCount, bool singleFileMode) {
         if (singleFileMode)
             readCompressed(pgrcIn, pgPos);
-        else {
-            bool deltaPairEncodingEnabled = (bool) pgrcIn.get();
-            vector<uint8_t> offsetInUint16Flag;
-            vector<uint8_t> offsetIsBaseFirstFlag;
-            vector<uint16_t> offsetInUint16Value;
-            vector<uint8_t> deltaInInt16Flag;
-            vector<uint8_t> deltaIsBaseFirstFlag;
-            vector<int16_t> deltaInInt16Value;
-            vector<uint_pg_len> notBasePairPos;
-            pgPos.reserve(readsTotalCount);
-            readCompressed(pgrcIn, pgPos);
-            readCompressed(pgrcIn, offsetInUint16Flag);
-            readCompressed(pgrcIn, offsetIsBaseFirstFlag);
-            readCompressed(pgrcIn, offsetInUint16Value);
-            if (deltaPairEncodingEnabled) {
-                readCompressed(pgrcIn, deltaInInt16Flag);
-                readCompressed(pgrcIn, deltaIsBaseFirstFlag);
-                readCompressed(pgrcIn, deltaInInt16Value);
-            }
-            readCompressed(pgrcIn, notBasePairPos);
-            const uint_reads_cnt_std pairsCount = readsTotalCount / 2;
-            vector<uint_reads_cnt_std> bppRank;
-            bppRank.reserve(pairsCount);
-            for (uint_reads_cnt_std p = 0; p < pairsCount; p++)
-                bppRank.push_back(p);
-            __gnu_parallel::stable_sort(bppRank.begin(), bppRank.end(),
-                             [&](const uint_reads_cnt_std &idx1, const uint_reads_cnt_std &idx2) -> bool
-                             { return pgPos[idx1] < pgPos[idx2]; });
-
-            pgPos.resize(readsTotalCount);
-            int64_t nbpPos = 0;
-            int64_t offIdx = -1;
-            int64_t delFlagIdx = -1;
-            int64_t delIdx = -1;
-            int64_t nbpPosIdx = -1;
-            int64_t refPrev = 0;
-            int64_t prev = 0;
-            bool match = false;
-            for (uint_reads_cnt_std i = 0; i < pairsCount; i++) {
-                uint_reads_cnt_std p = bppRank[i];
-                if (offsetInUint16Flag[i] == 1) {
-                    int64_t delta = offsetInUint16Value[++offIdx];
-                    if (offsetIsBaseFirstFlag[offIdx] == 0)
-                        delta = -delta;
-                    nbpPos = pgPos[p] + delta;
-                } else if (deltaInInt16Flag[++delFlagIdx]){
-                    int64_t delta = refPrev + deltaInInt16Value[++delIdx];
-                    refPrev = delta;
-                    prev = delta;
-                    if (deltaIsBaseFirstFlag[delIdx] == 0)
-                        delta = -delta;
-                    nbpPos = pgPos[p] + delta;
-                    match = true;
-                } else {
-                    nbpPos = notBasePairPos[++nbpPosIdx];
-                    int64_t delta = nbpPos - pgPos[p];
-                    if (delta < 0)
-                        delta = -delta;
-                    if (!match || refPrev != prev)
-                        refPrev = delta;
-                    match = false;
-                    prev = delta;
-                }
-                pgPos[pairsCount + p] = nbpPos;
-            }
-        }
+        else if (isReadsCountStd(readsTotalCount))
+            decompressPairedReadsPgPositions<uint_pg_len, uint_reads_cnt_std>(pgrcIn, pgPos, readsTotalCount);
+        else
+            decompressPairedReadsPgPositions<uint_pg_len, uint_reads_cnt_max>(pgrcIn, pgPos, readsTotalCount);
     }
-    template void SeparatedPseudoGenomePersistence::decompressReadsPgPositions<uint_pg_len_std>(istream &pgrcIn, vector<uint_pg_len_std> &pgPos, uint_reads_cnt_std readsTotalCount, bool singleFileMode);
-    template void SeparatedPseudoGenomePersistence::decompressReadsPgPositions<uint_pg_len_max>(istream &pgrcIn, vector<uint_pg_len_max> &pgPos, uint_reads_cnt_std readsTotalCount, bool singleFileMode);
+    template void SeparatedPseudoGenomePersistence::decompressReadsPgPositions<uint_pg_len_std>(istream &pgrcIn, vector<uint_pg_len_std> &pgPos, uint_reads_cnt_max readsTotalCount, bool singleFileMode);
+    template void SeparatedPseudoGenomePersistence::decompressReadsPgPositions<uint_pg_len_max>(istream &pgrcIn, vector<uint_pg_len_max> &pgPos, uint_reads_cnt_max readsTotalCount, bool singleFileMode);
 
     SeparatedPseudoGenomeOutputBuilder::SeparatedPseudoGenomeOutputBuilder(const string pseudoGenomePrefix,
             bool disableRevComp, bool disableMismatches) : pseudoGenomePrefix(pseudoGenomePrefix),
@@ -808,7 +857,10 @@ namespace PgTools {
         }
         if (!this->disableMismatches) {
             *logout << "Mismatches counts... ";
-            compressDest(rlMisCntDest, pgrcOut, PPMD7_CODER, coder_level, 2, COMPRESSION_ESTIMATION_MIS_CNT);
+            // mismatches counts of long reads may use (almost) all bits of a byte
+            const double misCntEstimation = maxMismatchesCount ? std::max(COMPRESSION_ESTIMATION_MIS_CNT,
+                    simpleUintCompressionEstimate(maxMismatchesCount, UINT8_MAX)) : COMPRESSION_ESTIMATION_MIS_CNT;
+            compressDest(rlMisCntDest, pgrcOut, PPMD7_CODER, coder_level, 2, misCntEstimation);
             *logout << "Mismatched symbols codes... ";
             compressDest(rlMisSymDest, pgrcOut, PPMD7_CODER, coder_level, 2, COMPRESSION_ESTIMATION_MIS_SYM);
             *logout << "Mismatches offsets (rev-coded)... " << endl;
@@ -818,27 +870,58 @@ namespace PgTools {
 
     void SeparatedPseudoGenomeOutputBuilder::updateOriginalIndexesIn(SeparatedPseudoGenome *sPg) {
         string tmp = ((ostringstream *) rlOrgIdxDest)->str();
-        uint_reads_cnt_std *orgIdxPtr = (uint_reads_cnt_std *) tmp.data();
-        sPg->getReadsList()->orgIdx.assign(orgIdxPtr, orgIdxPtr + readsCounter);
+        ReadsIndexesVector &orgIdx = sPg->getReadsList()->orgIdx;
+        if (maxOrgIdxMode) {
+            orgIdx.useWideValues();
+            uint_reads_cnt_max *orgIdxPtr = (uint_reads_cnt_max *) tmp.data();
+            orgIdx.getWideVector().assign(orgIdxPtr, orgIdxPtr + readsCounter);
+        } else {
+            uint_reads_cnt_std *orgIdxPtr = (uint_reads_cnt_std *) tmp.data();
+            orgIdx.getNarrowVector().assign(orgIdxPtr, orgIdxPtr + readsCounter);
+        }
         sPg->getReadsList()->readsCount = readsCounter;
     }
 
+    void SeparatedPseudoGenomeOutputBuilder::useMaxOrgIdxs() {
+        if (onTheFlyMode()) {
+            fprintf(stderr, "Error: on-the-fly reads list output supports up to %u reads.\n", UINT_MAX - 1);
+            exit(EXIT_FAILURE);
+        }
+        istringstream stdOrgIdxSrc(((ostringstream*) rlOrgIdxDest)->str());
+        ostringstream* maxOrgIdxDest = new ostringstream();
+        uint_reads_cnt_std idx;
+        for(uint_reads_cnt_max i = 0; i < readsCounter; i++) {
+            PgSAHelpers::readValue<uint_reads_cnt_std>(stdOrgIdxSrc, idx, false);
+            PgSAHelpers::writeValue<uint_reads_cnt_max>(*maxOrgIdxDest, idx);
+        }
+        delete(rlOrgIdxDest);
+        rlOrgIdxDest = maxOrgIdxDest;
+        maxOrgIdxMode = true;
+    }
+
     void SeparatedPseudoGenomeOutputBuilder::writeReadEntry(const DefaultReadsListEntry &rlEntry) {
         lastWrittenPos = rlEntry.pos;
         if (SeparatedPseudoGenomePersistence::enableReadPositionRepresentation)
             PgSAHelpers::writeValue<uint_pg_len_max>(*rlPosDest, rlEntry.pos);
         else
             PgSAHelpers::writeReadLengthValue(*rlOffDest, rlEntry.offset);
-        PgSAHelpers::writeValue<uint_reads_cnt_std>(*rlOrgIdxDest, rlEntry.idx);
+        if (!maxOrgIdxMode && !isReadsCountStd(rlEntry.idx))
+            useMaxOrgIdxs();
+        if (maxOrgIdxMode)
+            PgSAHelpers::writeValue<uint_reads_cnt_max>(*rlOrgIdxDest, rlEntry.idx);
+        else
+            PgSAHelpers::writeValue<uint_reads_cnt_std>(*rlOrgIdxDest, rlEntry.idx);
         if (!disableRevComp)
             PgSAHelpers::writeValue<uint8_t>(*rlRevCompDest, rlEntry.revComp?1:0);
         if (!disableMismatches) {
             PgSAHelpers::writeValue<uint8_t>(*rlMisCntDest, rlEntry.mismatchesCount);
+            if (rlEntry.mismatchesCount > maxMismatchesCount)
+                maxMismatchesCount = rlEntry.mismatchesCount;
             if (rlEntry.mismatchesCount) {
                 for (uint8_t i = 0; i < rlEntry.mismatchesCount; i++)
                     PgSAHelpers::writeValue<uint8_t>(*rlMisSymDest, rlEntry.mismatchCode[i]);
                 if (SeparatedPseudoGenomePersistence::enableRevOffsetMismatchesRepresentation) {
-                    uint8_t currentPos = pgh->getMaxReadLength() - 1;
+                    uint_read_len_max currentPos = pgh->getMaxReadLength() - 1;
                     for (int16_t i = rlEntry.mismatchesCount - 1; i >= 0; i--) {
                         PgSAHelpers::writeReadLengthValue(*rlMisRevOffDest,
                                                                    currentPos - rlEntry.mismatchOffset[i]);
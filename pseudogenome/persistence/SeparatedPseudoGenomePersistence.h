@@ -17,8 +17,23 @@ namespace PgTools {
 
         static bool acceptTemporaryPseudoGenomeElement(const string &pseudoGenomePrefix, const string& fileSuffix, bool alwaysRemoveExisting);
 
-        static void appendIndexesFromPg(string pgFilePrefix, vector<uint_reads_cnt_std> &idxs);
-        static void writePairMapping(basic_string<char> &pgFilePrefix, vector<uint_reads_cnt_std> orgIdxs);
+        static void appendIndexesFromPg(string pgFilePrefix, ReadsIndexesVector &idxs);
+        static void writePairMapping(basic_string<char> &pgFilePrefix, const ReadsIndexesVector &orgIdxs);
+
+        template <typename uint_reads_cnt>
+        static void compressReadsOrderTemplate(ostream &pgrcOut, const vector<uint_reads_cnt>& orgIdxs,
+                uint8_t coder_level, bool completeOrderInfo, bool ignorePairOrderInformation, bool singleFileMode);
+        template <typename uint_reads_cnt>
+        static void decompressReadsOrderTemplate(istream &pgrcIn, vector<uint_reads_cnt>& rlIdxOrder,
+                bool completeOrderInfo, bool ignorePairOrderInformation, bool singleFileMode);
+
+        template <typename uint_pg_len, typename uint_reads_cnt>
+        static void compressPairedReadsPgPositions(ostream &pgrcOut, const vector<uint_pg_len_max> &orgIdx2PgPos,
+                uint8_t coder_level, bool deltaPairEncodingEnabled, int lzma_pos_dataperiod_param,
+                double estimated_pos_ratio);
+        template <typename uint_pg_len, typename uint_reads_cnt>
+        static void decompressPairedReadsPgPositions(istream &pgrcIn, vector<uint_pg_len> &pgPos,
+                uint_reads_cnt_max readsTotalCount);
 
     public:
         static void writePseudoGenome(PseudoGenomeBase* pgb, const string &pseudoGenomePrefix,
@@ -43,9 +58,10 @@ namespace PgTools {
         static bool enableRevOffsetMismatchesRepresentation;
 
         static void dumpPgPairs(vector<string> pgFilePrefixes);
-        static void compressReadsOrder(ostream &pgrcOut, const vector<uint_reads_cnt_std>& orgIdxs, uint8_t coder_level,
+        static void compressReadsOrder(ostream &pgrcOut, const ReadsIndexesVector& orgIdxs, uint8_t coder_level,
                 bool completeOrderInfo = false, bool ignorePairOrderInformation = false, bool singleFileMode = true);
-        static void decompressReadsOrder(istream &pgrcIn, vector<uint_reads_cnt_std>& rlIdxOrder,
+        // rlIdxOrder indexes width should be fitted to the total reads count
+        static void decompressReadsOrder(istream &pgrcIn, ReadsIndexesVector& rlIdxOrder,
                                        bool completeOrderInfo = false, bool ignorePairOrderInformation = false, bool singleFileMode = true);
 
         static void writePseudoGenomeSequence(string &pgSequence, string pgPrefix);
@@ -54,7 +70,7 @@ namespace PgTools {
         static void compressReadsPgPositions(ostream &pgrcOut, vector<uint_pg_len_max> orgIdx2PgPos,
                 uint_pg_len_max joinedPgLength, uint8_t coder_level, bool singleFileMode, bool deltaPairEncodingEnabled = true);
         template <typename uint_pg_len>
-        static void decompressReadsPgPositions(istream &pgrcIn, vector<uint_pg_len> &pgPos, uint_reads_cnt_std readsTotalCount, bool singleFileMode);
+        static void decompressReadsPgPositions(istream &pgrcIn, vector<uint_pg_len> &pgPos, uint_reads_cnt_max readsTotalCount, bool singleFileMode);
     };
 
     class SeparatedPseudoGenomeOutputBuilder {
@@ -86,6 +102,10 @@ namespace PgTools {
 
         uint_pg_len_max lastWrittenPos = 0;
         uint_reads_cnt_max readsCounter = 0;
+        bool maxOrgIdxMode = false;
+        uint8_t maxMismatchesCount = 0;
+
+        void useMaxOrgIdxs();
 
         PseudoGenomeHeader* pgh = 0;
         ReadsSetProperties* rsProp = 0;
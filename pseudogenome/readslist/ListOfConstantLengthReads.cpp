@@ -178,5 +178,9 @@ namespace PgSAIndex {
     template class ListOfConstantLengthReads<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_std, 9, 4>;
     template class ListOfConstantLengthReads<uint_read_len_min, uint_reads_cnt_std, uint_pg_len_max, 13, 8>;
     template class ListOfConstantLengthReads<uint_read_len_std, uint_reads_cnt_std, uint_pg_len_max, 13, 8>;
+    template class ListOfConstantLengthReads<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_std, 13, 4>;
+    template class ListOfConstantLengthReads<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_std, 13, 4>;
+    template class ListOfConstantLengthReads<uint_read_len_min, uint_reads_cnt_max, uint_pg_len_max, 17, 8>;
+    template class ListOfConstantLengthReads<uint_read_len_std, uint_reads_cnt_max, uint_pg_len_max, 17, 8>;
         
 }
\ No newline at end of file
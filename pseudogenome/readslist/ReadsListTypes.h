@@ -22,6 +22,16 @@ namespace PgSAIndex {
         typedef ListOfConstantLengthReads<uint_read_len, uint_reads_cnt_std, uint_pg_len_max, 13, 8> Type;
     };
 
+    template<typename uint_read_len>
+    struct ListOfConstantLengthReadsTypeTemplate<uint_read_len, uint_reads_cnt_max, uint_pg_len_std> {
+        typedef ListOfConstantLengthReads<uint_read_len, uint_reads_cnt_max, uint_pg_len_std, 13, 4> Type;
+    };
+
+    template<typename uint_read_len>
+    struct ListOfConstantLengthReadsTypeTemplate<uint_read_len, uint_reads_cnt_max, uint_pg_len_max> {
+        typedef ListOfConstantLengthReads<uint_read_len, uint_reads_cnt_max, uint_pg_len_max, 17, 8> Type;
+    };
+
 }
 
 #endif // READSLISTTYPES_H_INCLUDED
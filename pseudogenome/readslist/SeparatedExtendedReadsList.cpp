@@ -55,6 +55,8 @@ namespace PgTools {
     void SeparatedExtendedReadsListIterator<maxMismatches>::initSrcs() {
         initSrc(rlPosSrc, SeparatedPseudoGenomeBase::READSLIST_POSITIONS_FILE_SUFFIX);
         initSrc(rlOrgIdxSrc, SeparatedPseudoGenomeBase::READSLIST_ORIGINAL_INDEXES_FILE_SUFFIX);
+        if (rlOrgIdxSrc)
+            orgIdxBytes = SeparatedPseudoGenomeBase::getOriginalIndexBytes(*rlOrgIdxSrc, pgh->getReadsCount());
         initSrc(rlRevCompSrc, SeparatedPseudoGenomeBase::READSLIST_REVERSECOMPL_FILE_SUFFIX);
         initSrc(rlMisCntSrc, SeparatedPseudoGenomeBase::READSLIST_MISMATCHES_COUNT_FILE_SUFFIX);
         if (maxMismatches == 0 && rlMisCntSrc) {
@@ -137,6 +139,8 @@ namespace PgTools {
         decompressMisRevOffSrc(pgrcIn);
 
         initSrc(rlOrgIdxSrc, SeparatedPseudoGenomeBase::READSLIST_ORIGINAL_INDEXES_FILE_SUFFIX);
+        if (rlOrgIdxSrc)
+            orgIdxBytes = SeparatedPseudoGenomeBase::getOriginalIndexBytes(*rlOrgIdxSrc, pgh->getReadsCount());
     }
 
     template <int maxMismatches>
@@ -165,9 +169,9 @@ namespace PgTools {
     template <int maxMismatches>
     bool SeparatedExtendedReadsListIterator<maxMismatches>::moveNext() {
         if (++current < pgh->getReadsCount()) {
-            uint_reads_cnt_std idx = 0;
+            uint_reads_cnt_max idx = SeparatedPseudoGenomeBase::readOriginalIndex(*rlOrgIdxSrc, orgIdxBytes,
+                    plainTextReadMode);
             uint8_t revComp = 0;
-            PgSAHelpers::readValue<uint_reads_cnt_std>(*rlOrgIdxSrc, idx, plainTextReadMode);
             if (rlRevCompSrc)
                 PgSAHelpers::readValue<uint8_t>(*rlRevCompSrc, revComp, plainTextReadMode);
             if (rlOffSrc) {
@@ -240,8 +244,10 @@ namespace PgTools {
 
         const uint_reads_cnt_max readsCount = rl.pgh->getReadsCount();
         if (rl.rlOrgIdxSrc) {
+            if (rl.orgIdxBytes == sizeof(uint_reads_cnt_max))
+                res->orgIdx.useWideValues();
             res->orgIdx.resize(readsCount);
-            PgSAHelpers::readArray(*(rl.rlOrgIdxSrc), res->orgIdx.data(), sizeof(uint_reads_cnt_std) * readsCount);
+            PgSAHelpers::readArray(*(rl.rlOrgIdxSrc), res->orgIdx.data(), res->orgIdx.dataSize());
         } else
             res->orgIdx.resize(readsCount, 0);
         if (rl.rlRevCompSrc) {
@@ -278,11 +284,17 @@ namespace PgTools {
             res->misOff.resize(cumCount);
             bool misRevOffMode = rl.rlMisOffSrc == 0;
             PgSAHelpers::readArray(misRevOffMode?*(rl.rlMisRevOffSrc):*(rl.rlMisOffSrc), res->misOff.data(),
-                    sizeof(uint8_t) * cumCount);
+                    res->misOff.dataSize());
             if (misRevOffMode) {
                 for (uint_reads_cnt_max i = 0; i < readsCount; i++) {
-                    PgSAHelpers::convertMisRevOffsets2Offsets<uint8_t>(res->misOff.data() + res->misCumCount[i],
-                            res->getMisCount(i), res->readLength);
+                    if (res->misOff.isNarrow())
+                        PgSAHelpers::convertMisRevOffsets2Offsets<uint_read_len_min>(
+                                res->misOff.getNarrowVector().data() + res->misCumCount[i],
+                                res->getMisCount(i), res->readLength);
+                    else
+                        PgSAHelpers::convertMisRevOffsets2Offsets<uint_read_len_std>(
+                                res->misOff.getWideVector().data() + res->misCumCount[i],
+                                res->getMisCount(i), res->readLength);
                 }
             }
         }
@@ -290,44 +302,59 @@ namespace PgTools {
         return res;
     }
 
+    template<typename uint_read_len>
+    void ExtendedReadsListWithConstantAccessOption::readCompressedMisRevOffsetsTemplate(istream &pgrcIn,
+            vector<uint_read_len> &misOffValues) {
+        uint8_t mismatchesCountSrcsLimit = 0;
+        PgSAHelpers::readValue<uint8_t>(pgrcIn, mismatchesCountSrcsLimit, false);
+        vector<uint8_t> misCnt2SrcIdx(UINT8_MAX, mismatchesCountSrcsLimit);
+        for (uint8_t m = 1; m < mismatchesCountSrcsLimit; m++)
+            PgSAHelpers::readValue<uint8_t>(pgrcIn, misCnt2SrcIdx[m], false);
+        vector<uint_read_len> srcs[UINT8_MAX];
+        vector<uint64_t> srcCounter(UINT8_MAX, 0);
+        for (uint8_t m = 1; m <= mismatchesCountSrcsLimit; m++) {
+            *logout << (int) m << ": ";
+            readCompressed(pgrcIn, srcs[m]);
+        }
+        misOffValues.reserve(misSymCode.size());
+        for (uint_reads_cnt_max i = 0; i < misCnt.size(); i++) {
+            uint8_t mismatchesCount = misCnt[i];
+            uint8_t srcIdx = misCnt2SrcIdx[mismatchesCount];
+            uint64_t misOffStartIdx = misOffValues.size();
+            for (uint8_t m = 0; m < mismatchesCount; m++)
+                misOffValues.push_back(srcs[srcIdx][srcCounter[srcIdx]++]);
+            PgSAHelpers::convertMisRevOffsets2Offsets<uint_read_len>(misOffValues.data() + misOffStartIdx,
+                                                                     mismatchesCount, readLength);
+        }
+    }
+
     ExtendedReadsListWithConstantAccessOption* ExtendedReadsListWithConstantAccessOption::loadConstantAccessExtendedReadsList(
             istream& pgrcIn, PseudoGenomeHeader* pgh, ReadsSetProperties* rsProp, const string validationPgPrefix,
             bool preserveOrderMode, bool disableRevCompl, bool disableMismatches) {
         ExtendedReadsListWithConstantAccessOption *res = new ExtendedReadsListWithConstantAccessOption(pgh->getMaxReadLength());
         const uint_reads_cnt_max readsCount = pgh->getReadsCount();
-        if (!preserveOrderMode)
-            readCompressed(pgrcIn, res->off);
+        if (!preserveOrderMode) {
+            if (res->off.isNarrow())
+                readCompressed(pgrcIn, res->off.getNarrowVector());
+            else
+                readCompressed(pgrcIn, res->off.getWideVector());
+        }
         if (!disableRevCompl)
             readCompressed(pgrcIn, res->revComp);
         if (!disableMismatches) {
             readCompressed(pgrcIn, res->misCnt);
             readCompressed(pgrcIn, res->misSymCode);
-            uint8_t mismatchesCountSrcsLimit = 0;
-            PgSAHelpers::readValue<uint8_t>(pgrcIn, mismatchesCountSrcsLimit, false);
-            vector<uint8_t> misCnt2SrcIdx(UINT8_MAX, mismatchesCountSrcsLimit);
-            for (uint8_t m = 1; m < mismatchesCountSrcsLimit; m++)
-                PgSAHelpers::readValue<uint8_t>(pgrcIn, misCnt2SrcIdx[m], false);
-            vector<uint8_t> srcs[UINT8_MAX];
-            vector<uint_reads_cnt_std> srcCounter(UINT8_MAX, 0);
-            for (uint8_t m = 1; m <= mismatchesCountSrcsLimit; m++) {
-                *logout << (int) m << ": ";
-                readCompressed(pgrcIn, srcs[m]);
-            }
-            res->misOff.reserve(res->misSymCode.size());
-            for (uint_reads_cnt_max i = 0; i < readsCount; i++) {
-                uint8_t misCnt = res->misCnt[i];
-                uint8_t srcIdx = misCnt2SrcIdx[misCnt];
-                uint64_t misOffStartIdx = res->misOff.size();
-                for (uint8_t m = 0; m < misCnt; m++)
-                    res->misOff.push_back(srcs[srcIdx][srcCounter[srcIdx]++]);
-                PgSAHelpers::convertMisRevOffsets2Offsets<uint8_t>(res->misOff.data() + misOffStartIdx,
-                                                                   res->misCnt[i], res->readLength);
-            }
+            if (res->misOff.isNarrow())
+                res->readCompressedMisRevOffsetsTemplate(pgrcIn, res->misOff.getNarrowVector());
+            else
+                res->readCompressedMisRevOffsetsTemplate(pgrcIn, res->misOff.getWideVector());
         }
         if (!validationPgPrefix.empty()) {
             std::ifstream in((validationPgPrefix + SeparatedPseudoGenomeBase::READSLIST_ORIGINAL_INDEXES_FILE_SUFFIX).c_str(), std::ifstream::binary);
+            if (SeparatedPseudoGenomeBase::getOriginalIndexBytes(in, readsCount) == sizeof(uint_reads_cnt_max))
+                res->orgIdx.useWideValues();
             res->orgIdx.resize(readsCount);
-            readArray(in, res->orgIdx.data(), readsCount * sizeof(uint_reads_cnt_std));
+            readArray(in, res->orgIdx.data(), res->orgIdx.dataSize());
         }
         cout << "Loaded Pg reads list containing " << readsCount << " reads." << endl;
         return res;
@@ -359,7 +386,7 @@ namespace PgTools {
         return !this->misCumCount.empty() || !this->misOff.empty();
     }
 
-    bool ExtendedReadsListWithConstantAccessOption::getRevComp(uint_reads_cnt_std idx) {
+    bool ExtendedReadsListWithConstantAccessOption::getRevComp(uint_reads_cnt_max idx) {
         return isRevCompEnabled()?revComp[idx]:false;
     }
 
@@ -371,7 +398,7 @@ namespace PgTools {
                 currPos += off[i];
                 this->pos.push_back(currPos);
             }
-            this->pos.push_back(this->pos.back() + this->readLength);
+            this->pos.push_back((this->pos.empty() ? 0 : this->pos.back()) + this->readLength);
         }
         if (disableIterationMode)
             off.clear();
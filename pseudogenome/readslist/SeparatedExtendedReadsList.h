@@ -4,6 +4,8 @@
 #include "iterator/ExtendedReadsListIteratorInterface.h"
 #include "../SeparatedPseudoGenomeBase.h"
 #include "../../utils/SymbolsPackingFacility.h"
+#include "../../readsset/ReadsIndexesVector.h"
+#include "../../utils/VariableWidthVector.h"
 #include "../DefaultPseudoGenome.h"
 
 namespace PgTools {
@@ -14,29 +16,40 @@ namespace PgTools {
     typedef SeparatedExtendedReadsListIterator<UINT8_MAX> DefaultSeparatedExtendedReadsListIterator;
     typedef SeparatedExtendedReadsListIterator<0> SimpleSeparatedReadsListIterator;
 
+    // read offsets stored in uint_read_len_min for reads of up to UCHAR_MAX symbols
+    typedef PgSAHelpers::VariableWidthVector<uint_read_len_min, uint_read_len_std> ReadOffsetsVector;
+
     class ExtendedReadsListWithConstantAccessOption : public DefaultReadsListIteratorInterface {
 
         DefaultReadsListEntry entry;
         int64_t current = -1;
         uint64_t curMisCumCount = 0;
 
+        template<typename uint_read_len>
+        void readCompressedMisRevOffsetsTemplate(istream &pgrcIn, vector<uint_read_len> &misOffValues);
+
     public:
 
         uint_read_len_max readLength;
-        uint_reads_cnt_std readsCount;
+        uint_reads_cnt_max readsCount;
 
-        vector<uint_read_len_min> off;
-        vector<uint_reads_cnt_std> orgIdx;
+        ReadOffsetsVector off;
+        ReadsIndexesVector orgIdx;
         vector<uint8_t> revComp;
         vector<uint_read_len_min> misCnt;
         vector<uint8_t> misSymCode;
-        vector<uint_read_len_min> misOff;
+        ReadOffsetsVector misOff;
 
         // constant access features
         vector<uint_pg_len_max> pos;
-        vector<uint_reads_cnt_max> misCumCount;
+        ReadsIndexesVector misCumCount;
 
-        ExtendedReadsListWithConstantAccessOption(uint_read_len_max readLength) : readLength(readLength) {}
+        ExtendedReadsListWithConstantAccessOption(uint_read_len_max readLength) : readLength(readLength) {
+            if (!isReadLengthMin(readLength)) {
+                off.useWideValues();
+                misOff.useWideValues();
+            }
+        }
 
         virtual ~ExtendedReadsListWithConstantAccessOption() {};
 
@@ -52,7 +65,7 @@ namespace PgTools {
             return misSymCode[misCumCount[rlIdx] + misIdx];
         }
 
-        inline uint8_t getMisOff(uint_reads_cnt_max rlIdx, uint8_t misIdx) {
+        inline uint_read_len_max getMisOff(uint_reads_cnt_max rlIdx, uint8_t misIdx) {
             return misOff[misCumCount[rlIdx] + misIdx];
         }
 
@@ -88,7 +101,7 @@ namespace PgTools {
 
         bool areMismatchesEnabled();
 
-        bool getRevComp(uint_reads_cnt_std idx);
+        bool getRevComp(uint_reads_cnt_max idx);
     };
 
     template<int maxMismatches>
@@ -101,6 +114,7 @@ namespace PgTools {
 
         istream *rlPosSrc = 0;
         istream *rlOrgIdxSrc = 0;
+        uchar orgIdxBytes = sizeof(uint_reads_cnt_std);
         istream *rlRevCompSrc = 0;
         istream *rlMisCntSrc = 0;
         istream *rlMisSymSrc = 0;
@@ -1,12 +1,26 @@
 #include "DividedPCLReadsSets.h"
 
 #include "iterator/DivisionReadsSetDecorators.h"
+#include "iterator/GzipInputStreamBuf.h"
+#include "persistance/ReadsSetPersistence.h"
+
+#include <sys/mman.h>
 
 namespace PgTools {
     static const char *const DNA_SYMBOLS = "ACGT";
 
     static const char *const DNA_AND_N_SYMBOLS = "ACGNT";
 
+    static const size_t MIN_FASTQ_CHUNK_SIZE = 1 << 20;
+    static const size_t FASTQ_READS_BATCH_SIZE = 1 << 12;
+    static const uint_reads_cnt_max DIVISION_CHUNK_SIZE = 1 << 16;
+
+    static const uint8_t HQ_TARGET_SET = 0;
+    static const uint8_t LQ_TARGET_SET = 1;
+    static const uint8_t N_TARGET_SET = 2;
+    static const int TARGET_SETS_COUNT = 3;
+    static const int FASTQ_CHUNKS_PER_THREAD = 4;
+
     DividedPCLReadsSets::DividedPCLReadsSets(uint_read_len_max readLength, bool separateNReadsSet, bool nReadsLQ) :
                                        nReadsLQ(nReadsLQ), separateNReadsSet(separateNReadsSet) {
         if (separateNReadsSet || nReadsLQ)
@@ -59,40 +73,278 @@ namespace PgTools {
     DividedPCLReadsSets::getQualityDivisionBasedReadsSets(ReadsSourceIteratorTemplate<uint_read_len_max> *readsIt,
                                                           uint_read_len_max readLength,
                                                           double error_limit, bool separateNReadsSet, bool nReadsLQ) {
-        DividedPCLReadsSets* readsSets = new DividedPCLReadsSets(readLength, separateNReadsSet, nReadsLQ);
+        vector<uint8_t> readsQualityClass;
+        PackedConstantLengthReadsSet* allReadsSet = loadReadsSetWithQualityClasses(readsIt, error_limit, readsQualityClass);
+        DividedPCLReadsSets* readsSets = getQualityClassBasedReadsSets(allReadsSet, readsQualityClass,
+                separateNReadsSet, nReadsLQ);
+        delete (allReadsSet);
+        return readsSets;
+    }
+
+    PackedConstantLengthReadsSet*
+    DividedPCLReadsSets::loadReadsSetWithQualityClasses(ReadsSourceIteratorTemplate<uint_read_len_max> *readsIt,
+                                                        double error_limit, vector<uint8_t> &readsQualityClass) {
         time_checkpoint();
-        QualityDividingReadsSetIterator<uint_read_len_max> *divReadsIt =
-                new QualityDividingReadsSetIterator<uint_read_len_max>(readsIt, error_limit);
-        vector<uint_reads_cnt_max> lqMapping, nMapping;
-        while (divReadsIt->moveNext()) {
-            if (separateNReadsSet || nReadsLQ) {
-                if (divReadsIt->containsN()) {
-                    (separateNReadsSet ? readsSets->nReadsSet : readsSets->lqReadsSet)->addRead(
-                            divReadsIt->getRead().data(), divReadsIt->getReadLength());
-                    (separateNReadsSet ? nMapping : lqMapping).push_back(divReadsIt->getReadOriginalIndex());
-                    continue;
+        QualityDividingReadsSetIterator<uint_read_len_max> divReadsIt(readsIt, error_limit);
+        const bool qualityDivision = error_limit < 1;
+        PackedConstantLengthReadsSet* allReadsSet = 0;
+        readsQualityClass.clear();
+        while (divReadsIt.moveNext()) {
+            const string read = divReadsIt.getRead();
+            if (!allReadsSet)
+                allReadsSet = new PackedConstantLengthReadsSet(divReadsIt.getReadLength(), DNA_AND_N_SYMBOLS, 5);
+            allReadsSet->addRead(read.data(), divReadsIt.getReadLength());
+            uint8_t qualityClass = HQ_READ_CLASS;
+            if (read.find('N') != string::npos)
+                qualityClass |= N_READ_CLASS_FLAG;
+            if (qualityDivision && !divReadsIt.isQualityHigh())
+                qualityClass |= LQ_READ_CLASS_FLAG;
+            readsQualityClass.push_back(qualityClass);
+        }
+        if (!allReadsSet) {
+            fprintf(stderr, "Error: no reads found in the input.\n");
+            exit(EXIT_FAILURE);
+        }
+        cout << "Loaded " << allReadsSet->readsCount() << " reads in " << time_millis() << " msec." << endl;
+        return allReadsSet;
+    }
+
+    static inline const char* nextLineStart(const char* line, const char* end) {
+        const char* lineEnd = (const char*) memchr(line, '\n', end - line);
+        return lineEnd ? lineEnd + 1 : end;
+    }
+
+    static inline uint_read_len_max readLengthAt(const char* line, const char* end) {
+        return scanReadLength<uint_read_len_max>(line, end);
+    }
+
+    // first record beginning at or after pos: a '@' line followed by a read of readLength symbols and a '+' line
+    static const char* findFASTQRecordStart(const char* pos, const MappedReadsFile &file, uint_read_len_max readLength) {
+        const char* end = file.end();
+        const char* line = (pos == file.data || pos[-1] == '\n') ? pos : nextLineStart(pos, end);
+        while (line < end) {
+            if (*line == '@') {
+                const char* readLine = nextLineStart(line, end);
+                const char* sepLine = nextLineStart(readLine, end);
+                if (sepLine < end && *sepLine == '+' && readLengthAt(readLine, end) == readLength)
+                    return line;
+            }
+            line = nextLineStart(line, end);
+        }
+        return end;
+    }
+
+    static void loadFASTQChunks(const MappedReadsFile &file, uint_read_len_max readLength, bool revComplReads,
+            double error_limit, vector<PackedConstantLengthReadsSet*> &chunkReadsSets,
+            vector<vector<uint8_t>> &chunkQualityClasses) {
+        const size_t chunksCount = std::min<size_t>(numberOfThreads * FASTQ_CHUNKS_PER_THREAD,
+                file.size / MIN_FASTQ_CHUNK_SIZE + 1);
+        vector<const char*> chunkBeg(chunksCount + 1);
+        #pragma omp parallel for
+        for (int64_t c = 0; c < chunksCount; c++)
+            chunkBeg[c] = findFASTQRecordStart(file.data + file.size / chunksCount * c, file, readLength);
+        chunkBeg[chunksCount] = file.end();
+
+        const bool qualityDivision = error_limit < 1;
+        chunkReadsSets.resize(chunksCount);
+        chunkQualityClasses.resize(chunksCount);
+        #pragma omp parallel for schedule(dynamic)
+        for (int64_t c = 0; c < chunksCount; c++) {
+            PackedConstantLengthReadsSet* readsSet = new PackedConstantLengthReadsSet(readLength, DNA_AND_N_SYMBOLS, 5);
+            vector<uint8_t> &qualityClasses = chunkQualityClasses[c];
+            MappedReadsFile chunk = file;
+            chunk.pos = chunkBeg[c];
+            vector<char> readsBatch((size_t) readLength * FASTQ_READS_BATCH_SIZE);
+            size_t batchCount = 0;
+            string quality;
+            const char* lineEnd;
+            while (chunk.pos < chunkBeg[c + 1]) {
+                chunk.nextLine(lineEnd);
+                const char* readPtr = chunk.nextLine(lineEnd);
+                const uint_read_len_max length = readLengthAt(readPtr, lineEnd);
+                chunk.nextLine(lineEnd);
+                const char* qualityPtr = chunk.nextLine(lineEnd);
+                if (length != readLength) {
+                    fprintf(stderr, "Unsupported variable length reads.\n");
+                    exit(EXIT_FAILURE);
                 }
+                char* read = readsBatch.data() + (size_t) readLength * batchCount;
+                memcpy(read, readPtr, length);
+                uint8_t qualityClass = HQ_READ_CLASS;
+                if (memchr(read, 'N', length))
+                    qualityClass |= N_READ_CLASS_FLAG;
+                if (revComplReads)
+                    reverseComplementInPlace(read, length);
+                if (++batchCount == FASTQ_READS_BATCH_SIZE) {
+                    readsSet->addReads(readsBatch.data(), readLength, batchCount);
+                    batchCount = 0;
+                }
+                if (qualityDivision) {
+                    quality.assign(qualityPtr, std::min<size_t>(lineEnd - qualityPtr, length));
+                    if (revComplReads)
+                        std::reverse(quality.begin(), quality.end());
+                    if (!QualityDividingReadsSetIterator<uint_read_len_max>::isQualityHigh(quality, error_limit))
+                        qualityClass |= LQ_READ_CLASS_FLAG;
+                }
+                qualityClasses.push_back(qualityClass);
             }
-            if (!divReadsIt->isQualityHigh()) {
-                readsSets->lqReadsSet->addRead(
-                        divReadsIt->getRead().data(), divReadsIt->getReadLength());
-                lqMapping.push_back(divReadsIt->getReadOriginalIndex());
-            } else {
-                readsSets->hqReadsSet->addRead(divReadsIt->getRead().data(), divReadsIt->getReadLength());
+            readsSet->addReads(readsBatch.data(), readLength, batchCount);
+            chunkReadsSets[c] = readsSet;
+        }
+    }
+
+    PackedConstantLengthReadsSet*
+    DividedPCLReadsSets::loadReadsSetWithQualityClasses(const string &srcFile, const string &pairFile,
+                                                        bool revComplPairFile, double error_limit,
+                                                        vector<uint8_t> &readsQualityClass) {
+        const bool pairedReads = pairFile != "";
+        const bool streamInput = ReadsSetPersistence::isStreamSource(srcFile) ||
+                (pairedReads && ReadsSetPersistence::isStreamSource(pairFile));
+        const bool plainFASTQ = !streamInput && !GzipInputStreamBuf::isGzipFile(srcFile) &&
+                (!pairedReads || !GzipInputStreamBuf::isGzipFile(pairFile));
+        MappedReadsFile files[2];
+        if (plainFASTQ)
+            files[0].map(srcFile, MADV_WILLNEED);
+        if (!plainFASTQ || files[0].size == 0 || *files[0].data != '@') {
+            files[0].unmap();
+            ReadsSourceIteratorTemplate<uint_read_len_max> *allReadsIterator =
+                    ReadsSetPersistence::createManagedReadsIterator(srcFile, pairFile, revComplPairFile);
+            PackedConstantLengthReadsSet* allReadsSet = loadReadsSetWithQualityClasses(allReadsIterator, error_limit,
+                    readsQualityClass);
+            delete (allReadsIterator);
+            return allReadsSet;
+        }
+        time_checkpoint();
+        const uint_read_len_max readLength = readLengthAt(nextLineStart(files[0].data, files[0].end()), files[0].end());
+        if (pairedReads)
+            files[1].map(pairFile, MADV_WILLNEED);
+
+        const int filesCount = pairedReads ? 2 : 1;
+        vector<PackedConstantLengthReadsSet*> chunkReadsSets[2];
+        vector<vector<uint8_t>> chunkQualityClasses[2];
+        vector<uint_reads_cnt_max> chunkReadsBeg[2];
+        for (int f = 0; f < filesCount; f++) {
+            loadFASTQChunks(files[f], readLength, f == 1 && revComplPairFile, error_limit,
+                    chunkReadsSets[f], chunkQualityClasses[f]);
+            chunkReadsBeg[f].resize(chunkReadsSets[f].size() + 1, 0);
+            for (size_t c = 0; c < chunkReadsSets[f].size(); c++)
+                chunkReadsBeg[f][c + 1] = chunkReadsBeg[f][c] + chunkReadsSets[f][c]->readsCount();
+            files[f].unmap();
+        }
+        const uint_reads_cnt_max srcReadsCount = chunkReadsBeg[0].back();
+        uint_reads_cnt_max readsTotalCount = srcReadsCount;
+        if (pairedReads) {
+            const uint_reads_cnt_max pairReadsCount = chunkReadsBeg[1].back();
+            readsTotalCount = std::min(srcReadsCount, pairReadsCount) * 2 + (srcReadsCount > pairReadsCount ? 1 : 0);
+        }
+
+        // chunks are appended in the reads order and freed as soon as they are consumed,
+        // so the packed reads are not held twice in memory
+        PackedConstantLengthReadsSet* allReadsSet = new PackedConstantLengthReadsSet(readLength, DNA_AND_N_SYMBOLS, 5);
+        allReadsSet->reserve(readsTotalCount);
+        readsQualityClass.clear();
+        readsQualityClass.reserve(readsTotalCount);
+        size_t chunk[2] = { 0, 0 };
+        uint_reads_cnt_max chunkPos[2] = { 0, 0 };
+        for (uint_reads_cnt_max idx = 0; idx < readsTotalCount;) {
+            const int f = pairedReads ? idx % 2 : 0;
+            while (chunkPos[f] == chunkReadsSets[f][chunk[f]]->readsCount()) {
+                delete (chunkReadsSets[f][chunk[f]]);
+                vector<uint8_t>().swap(chunkQualityClasses[f][chunk[f]++]);
+                chunkPos[f] = 0;
+            }
+            const uint_reads_cnt_max n = pairedReads ? 1 : std::min<uint_reads_cnt_max>(readsTotalCount - idx,
+                    chunkReadsSets[f][chunk[f]]->readsCount() - chunkPos[f]);
+            allReadsSet->addPackedReads(chunkReadsSets[f][chunk[f]]->getPackedRead(chunkPos[f]), n);
+            const auto &qualityClasses = chunkQualityClasses[f][chunk[f]];
+            readsQualityClass.insert(readsQualityClass.end(), qualityClasses.begin() + chunkPos[f],
+                    qualityClasses.begin() + chunkPos[f] + n);
+            chunkPos[f] += n;
+            idx += n;
+        }
+        for (int f = 0; f < filesCount; f++)
+            for (size_t c = chunk[f]; c < chunkReadsSets[f].size(); c++)
+                delete (chunkReadsSets[f][c]);
+        if (readsTotalCount == 0) {
+            fprintf(stderr, "Error: no reads found in the input.\n");
+            exit(EXIT_FAILURE);
+        }
+        cout << "Loaded " << readsTotalCount << " reads in " << time_millis() << " msec." << endl;
+        return allReadsSet;
+    }
+
+    static inline uint8_t getReadTargetSet(uint8_t qualityClass, bool separateNReadsSet, bool divideNReads) {
+        if (divideNReads && (qualityClass & N_READ_CLASS_FLAG))
+            return separateNReadsSet ? N_TARGET_SET : LQ_TARGET_SET;
+        return (qualityClass & LQ_READ_CLASS_FLAG) ? LQ_TARGET_SET : HQ_TARGET_SET;
+    }
+
+    DividedPCLReadsSets*
+    DividedPCLReadsSets::getQualityClassBasedReadsSets(PackedConstantLengthReadsSet* allReadsSet,
+                                                       const vector<uint8_t> &readsQualityClass,
+                                                       bool separateNReadsSet, bool nReadsLQ) {
+        DividedPCLReadsSets* readsSets = new DividedPCLReadsSets(allReadsSet->maxReadLength(), separateNReadsSet, nReadsLQ);
+        time_checkpoint();
+        const uint_reads_cnt_max readsTotalCount = allReadsSet->readsCount();
+        const bool divideNReads = separateNReadsSet || nReadsLQ;
+        const int64_t chunksCount = (readsTotalCount + DIVISION_CHUNK_SIZE - 1) / DIVISION_CHUNK_SIZE;
+        vector<uint_reads_cnt_max> chunkBeg[TARGET_SETS_COUNT];
+        for (int t = 0; t < TARGET_SETS_COUNT; t++)
+            chunkBeg[t].resize(chunksCount + 1, 0);
+        #pragma omp parallel for
+        for (int64_t c = 0; c < chunksCount; c++) {
+            const uint_reads_cnt_max chunkEnd = std::min<uint_reads_cnt_max>((c + 1) * DIVISION_CHUNK_SIZE, readsTotalCount);
+            for (uint_reads_cnt_max i = c * DIVISION_CHUNK_SIZE; i < chunkEnd; i++)
+                chunkBeg[getReadTargetSet(readsQualityClass[i], separateNReadsSet, divideNReads)][c + 1]++;
+        }
+        for (int t = 0; t < TARGET_SETS_COUNT; t++)
+            for (int64_t c = 0; c < chunksCount; c++)
+                chunkBeg[t][c + 1] += chunkBeg[t][c];
+
+        PackedConstantLengthReadsSet* targetSets[TARGET_SETS_COUNT] =
+                { readsSets->hqReadsSet, readsSets->lqReadsSet, readsSets->nReadsSet };
+        ReadsIndexesVector targetMappings[TARGET_SETS_COUNT];
+        for (int t = 0; t < TARGET_SETS_COUNT; t++) {
+            if (targetSets[t])
+                targetSets[t]->resize(chunkBeg[t][chunksCount]);
+            if (t != HQ_TARGET_SET) {
+                targetMappings[t].fitReadsCount(readsTotalCount);
+                targetMappings[t].resize(chunkBeg[t][chunksCount]);
+            }
+        }
+        #pragma omp parallel for
+        for (int64_t c = 0; c < chunksCount; c++) {
+            uint_reads_cnt_max targetIdx[TARGET_SETS_COUNT];
+            for (int t = 0; t < TARGET_SETS_COUNT; t++)
+                targetIdx[t] = chunkBeg[t][c];
+            string read;
+            read.resize(allReadsSet->maxReadLength());
+            const uint_reads_cnt_max chunkEnd = std::min<uint_reads_cnt_max>((c + 1) * DIVISION_CHUNK_SIZE, readsTotalCount);
+            for (uint_reads_cnt_max i = c * DIVISION_CHUNK_SIZE; i < chunkEnd; i++) {
+                const uint8_t t = getReadTargetSet(readsQualityClass[i], separateNReadsSet, divideNReads);
+                if (targetSets[t]->sPacker == allReadsSet->sPacker)
+                    targetSets[t]->copyPackedRead(allReadsSet->getPackedRead(i), targetIdx[t]);
+                else {
+                    allReadsSet->getRead(i, &read[0]);
+                    targetSets[t]->setRead(read.data(), targetIdx[t]);
+                }
+                if (t != HQ_TARGET_SET)
+                    targetMappings[t].set(targetIdx[t], i);
+                targetIdx[t]++;
             }
-        };
+        }
+        ReadsIndexesVector &lqMapping = targetMappings[LQ_TARGET_SET];
+        ReadsIndexesVector &nMapping = targetMappings[N_TARGET_SET];
         cout << "Filtered " << (lqMapping.size() + nMapping.size());
         if (separateNReadsSet)
             cout << " (including " << nMapping.size() << " containing N)";
-        cout << " reads (out of " <<
-            (divReadsIt->getReadOriginalIndex()) << ") in " << time_millis() << " msec." << endl;
+        cout << " reads (out of " << readsTotalCount << ") in " << time_millis() << " msec." << endl;
         *logout << endl;
 
-        readsSets->lqMapping = new VectorMapping(std::move(lqMapping), divReadsIt->getReadOriginalIndex());
+        readsSets->lqMapping = new VectorMapping(std::move(lqMapping), readsTotalCount);
         if (separateNReadsSet)
-            readsSets->nMapping = new VectorMapping(std::move(nMapping), divReadsIt->getReadOriginalIndex());
+            readsSets->nMapping = new VectorMapping(std::move(nMapping), readsTotalCount);
 
-        delete(divReadsIt);
         return readsSets;
     }
 
@@ -152,10 +404,10 @@ namespace PgTools {
         uint_reads_cnt_max lqCounter = lqReadsSet->readsCount();
         bool ignoreLqSet = (lqCounter-- == 0);
         lqReadsSet->resize(newLqCounter);
-        vector<uint_reads_cnt_max> &lqReadIdx = lqMapping->getMappingVector();
+        ReadsIndexesVector &lqReadIdx = lqMapping->getMappingVector();
         lqReadIdx.resize(newLqCounter + 1);
         uint_reads_cnt_max allCounter = lqMapping->getReadsTotalCount();
-        lqReadIdx[newLqCounter--] = allCounter;
+        lqReadIdx.set(newLqCounter--, allCounter);
         uint_reads_cnt_max nCounter = separateNReadsSet?nReadsSet->readsCount():0;
         bool ignoreNSet = (nCounter-- == 0);
         uint_reads_cnt_max hqCounter = hqReadsSet->readsCount();
@@ -170,7 +422,7 @@ namespace PgTools {
             if (!ignoreLqSet) {
                 if(lqMapping->getReadOriginalIndex(lqCounter) == allCounter) {
                     lqReadsSet->copyRead(lqCounter, newLqCounter);
-                    lqReadIdx[newLqCounter] = allCounter;
+                    lqReadIdx.set(newLqCounter, allCounter);
                     ignoreLqSet = (lqCounter-- == 0);
                     if (newLqCounter-- == 0)
                         break;
@@ -179,7 +431,7 @@ namespace PgTools {
             }
             if (!isReadHqInHqReadsSet[--hqCounter]) {
                 lqReadsSet->copyPackedRead(hqReadsSet->getPackedRead(hqCounter), newLqCounter);
-                lqReadIdx[newLqCounter] = allCounter;
+                lqReadIdx.set(newLqCounter, allCounter);
                 if (newLqCounter-- == 0)
                     break;
             }
@@ -194,7 +446,7 @@ namespace PgTools {
     }
 
     IndexesMapping* DividedPCLReadsSets::generateHqReadsIndexesMapping() {
-        vector<uint_reads_cnt_max> hqReadIdx;
+        ReadsIndexesVector hqReadIdx(lqMapping->getReadsTotalCount());
 //        hqReadIdx.reserve(lqMapping->getReadsTotalCount() -
 //            lqReadsSet->readsCount() - (separateNReadsSet?nReadsSet->readsCount():0));
         int64_t allCounter = -1;
@@ -213,32 +465,32 @@ namespace PgTools {
     }
 
     void DividedPCLReadsSets::removeReadsFromLqReadsSet(const vector<bool> &isLqReadMappedIntoHqPg) {
-        vector<uint_reads_cnt_max> &lqReadIdx = lqMapping->getMappingVector();
+        ReadsIndexesVector &lqReadIdx = lqMapping->getMappingVector();
         uint_reads_cnt_max newLqCounter = 0;
         for(uint_reads_cnt_max lqCounter = 0; lqCounter < lqReadsSet->readsCount(); lqCounter++) {
             if (!isLqReadMappedIntoHqPg[lqCounter]) {
-                lqReadIdx[newLqCounter] = lqReadIdx[lqCounter];
+                lqReadIdx.set(newLqCounter, lqReadIdx[lqCounter]);
                 lqReadsSet->copyRead(lqCounter, newLqCounter++);
             }
         }
         lqReadsSet->resize(newLqCounter);
-        lqReadIdx[newLqCounter++] = lqMapping->getReadsTotalCount();
+        lqReadIdx.set(newLqCounter++, lqMapping->getReadsTotalCount());
         lqReadIdx.resize(newLqCounter);
     }
 
 
     void DividedPCLReadsSets::removeReadsFromNReadsSet(const vector<bool> &isReadMappedIntoHqPg,
             uint_reads_cnt_max nBegIdx) {
-        vector<uint_reads_cnt_max> &nReadIdx = nMapping->getMappingVector();
+        ReadsIndexesVector &nReadIdx = nMapping->getMappingVector();
         uint_reads_cnt_max newNCounter = 0;
         for(uint_reads_cnt_max nCounter = 0; nCounter < nReadsSet->readsCount(); nCounter++) {
             if (!isReadMappedIntoHqPg[nCounter + nBegIdx]) {
-                nReadIdx[newNCounter] = nReadIdx[nCounter];
+                nReadIdx.set(newNCounter, nReadIdx[nCounter]);
                 nReadsSet->copyRead(nCounter, newNCounter++);
             }
         }
         nReadsSet->resize(newNCounter);
-        nReadIdx[newNCounter++] = nMapping->getReadsTotalCount();
+        nReadIdx.set(newNCounter++, nMapping->getReadsTotalCount());
         nReadIdx.resize(newNCounter);
     }
 
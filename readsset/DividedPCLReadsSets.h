@@ -7,6 +7,10 @@ using namespace PgSAReadsSet;
 
 namespace PgTools {
 
+    static const uint8_t HQ_READ_CLASS = 0;
+    static const uint8_t LQ_READ_CLASS_FLAG = 1;
+    static const uint8_t N_READ_CLASS_FLAG = 2;
+
     class DividedPCLReadsSets {
     private:
         PackedConstantLengthReadsSet* hqReadsSet = 0;
@@ -38,6 +42,18 @@ namespace PgTools {
                 ReadsSourceIteratorTemplate<uint_read_len_max> *readsIt, uint_read_len_max readLength,
                 double error_limit, bool separateNReadsSet = false, bool nReadsLQ = false);
 
+        static PackedConstantLengthReadsSet* loadReadsSetWithQualityClasses(
+                ReadsSourceIteratorTemplate<uint_read_len_max> *readsIt, double error_limit,
+                vector<uint8_t> &readsQualityClass);
+
+        static PackedConstantLengthReadsSet* loadReadsSetWithQualityClasses(
+                const string &srcFile, const string &pairFile, bool revComplPairFile, double error_limit,
+                vector<uint8_t> &readsQualityClass);
+
+        static DividedPCLReadsSets* getQualityClassBasedReadsSets(
+                PackedConstantLengthReadsSet* allReadsSet, const vector<uint8_t> &readsQualityClass,
+                bool separateNReadsSet = false, bool nReadsLQ = false);
+
         static DividedPCLReadsSets *
     getSimpleDividedPCLReadsSets(ReadsSourceIteratorTemplate<uint_read_len_max> *readsIt, uint_read_len_max readLength,
                                  bool separateNReadsSet, bool nReadsLQ);
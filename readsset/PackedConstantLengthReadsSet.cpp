@@ -38,10 +38,20 @@ namespace PgSAReadsSet {
             fprintf(stderr, "Unsupported variable length reads.\n");
             exit(EXIT_FAILURE);
         }
-        packedReads.resize((size_t) packedLength * ++properties->readsCount);
-        properties->allReadsLength += properties->minReadLength;
-        uint_ps_element_min *packedReadsPtr = packedReads.data() + (size_t) packedLength * (properties->readsCount - 1);
-        sPacker->packSequence(read, readLength, packedReadsPtr);
+        addReads(read, readLength, 1);
+    }
+
+    void PackedConstantLengthReadsSet::addReads(const char* base, size_t stride, size_t count) {
+        const uint_reads_cnt_max firstIdx = properties->readsCount;
+        properties->readsCount += count;
+        properties->allReadsLength += (size_t) properties->minReadLength * count;
+        packedReads.resize((size_t) packedLength * properties->readsCount);
+        for (size_t i = 0; i < count; i++)
+            setRead(base + stride * i, firstIdx + i);
+    }
+
+    void PackedConstantLengthReadsSet::setRead(const char* read, uint_reads_cnt_max destIdx) {
+        sPacker->packSequence(read, properties->maxReadLength, packedReads.data() + (size_t) packedLength * destIdx);
     }
 
     void PackedConstantLengthReadsSet::copyRead(uint_reads_cnt_max srcIdx, uint_reads_cnt_max destIdx,
@@ -56,6 +66,12 @@ namespace PgSAReadsSet {
                   packedReads.begin() + (size_t) packedLength * destIdx);
     }
 
+    void PackedConstantLengthReadsSet::addPackedReads(const uint_ps_element_min *packedSequence, uint_reads_cnt_max n) {
+        properties->readsCount += n;
+        properties->allReadsLength += (size_t) properties->minReadLength * n;
+        packedReads.insert(packedReads.end(), packedSequence, packedSequence + (size_t) packedLength * n);
+    }
+
     template<class ReadsSourceIterator>
     PackedConstantLengthReadsSet* PackedConstantLengthReadsSet::loadReadsSet(ReadsSourceIterator* readsIterator,
                                                                              ReadsSetProperties *properties) {
@@ -114,6 +130,44 @@ namespace PgSAReadsSet {
         return sPacker->countSequenceMismatchesVsUnpacked(packedReads.data() + i * (size_t) packedLength, pattern, length, maxMismatches);
     }
 
+    template<typename uint_read_len>
+    PackedConstantLengthReadsSetIterator<uint_read_len>::PackedConstantLengthReadsSetIterator(
+            PackedConstantLengthReadsSet* readsSet): readsSet(readsSet) {
+    }
+
+    template<typename uint_read_len>
+    PackedConstantLengthReadsSetIterator<uint_read_len>::~PackedConstantLengthReadsSetIterator() {
+    }
+
+    template<typename uint_read_len>
+    bool PackedConstantLengthReadsSetIterator<uint_read_len>::moveNext() {
+        if (counter + 1 >= readsSet->readsCount())
+            return false;
+        read.resize(readsSet->readLength(++counter));
+        readsSet->getRead(counter, &read[0]);
+        return true;
+    }
+
+    template<typename uint_read_len>
+    string PackedConstantLengthReadsSetIterator<uint_read_len>::getRead() {
+        return read;
+    }
+
+    template<typename uint_read_len>
+    uint_read_len PackedConstantLengthReadsSetIterator<uint_read_len>::getReadLength() {
+        return readsSet->readLength(counter);
+    }
+
+    template<typename uint_read_len>
+    void PackedConstantLengthReadsSetIterator<uint_read_len>::rewind() {
+        counter = -1;
+    }
+
+    template<typename uint_read_len>
+    IndexesMapping* PackedConstantLengthReadsSetIterator<uint_read_len>::retainVisitedIndexesMapping() {
+        return new DirectMapping(counter + 1);
+    }
+
     template PackedConstantLengthReadsSet* PackedConstantLengthReadsSet::loadReadsSet<ReadsSourceIteratorTemplate<uint_read_len_min>>(ReadsSourceIteratorTemplate<uint_read_len_min>* readsIterator, ReadsSetProperties* properties);
     template PackedConstantLengthReadsSet* PackedConstantLengthReadsSet::loadReadsSet<ReadsSourceIteratorTemplate<uint_read_len_std>>(ReadsSourceIteratorTemplate<uint_read_len_std>* readsIterator, ReadsSetProperties* properties);
     template PackedConstantLengthReadsSet* PackedConstantLengthReadsSet::loadReadsSet<ConcatenatedReadsSourceIterator<uint_read_len_min>>(ConcatenatedReadsSourceIterator<uint_read_len_min>* readsIterator, ReadsSetProperties* properties);
@@ -123,4 +177,7 @@ namespace PgSAReadsSet {
     template PackedConstantLengthReadsSet* PackedConstantLengthReadsSet::loadReadsSet<FASTQReadsSourceIterator<uint_read_len_min>>(FASTQReadsSourceIterator<uint_read_len_min>* readsIterator, ReadsSetProperties* properties);
     template PackedConstantLengthReadsSet* PackedConstantLengthReadsSet::loadReadsSet<FASTQReadsSourceIterator<uint_read_len_std>>(FASTQReadsSourceIterator<uint_read_len_std>* readsIterator, ReadsSetProperties* properties);
 
+    template class PackedConstantLengthReadsSetIterator<uint_read_len_min>;
+    template class PackedConstantLengthReadsSetIterator<uint_read_len_std>;
+
 }
@@ -15,7 +15,7 @@ namespace PgSAReadsSet {
     {
         private:
             vector<uint_ps_element_min> packedReads;
-            uchar packedLength;
+            uint_read_len_max packedLength;
 
         public:
 
@@ -27,9 +27,13 @@ namespace PgSAReadsSet {
             void reserve(uint_reads_cnt_max readsCount);
             void resize(uint_reads_cnt_max readsCount);
             void addRead(const char* read, uint_read_len_max readLength);
+            // appends count reads of maxReadLength symbols placed every stride bytes starting at base
+            void addReads(const char* base, size_t stride, size_t count);
+            void setRead(const char* read, uint_reads_cnt_max destIdx);
             void copyRead(uint_reads_cnt_max srcIdx, uint_reads_cnt_max destIdx, uint_reads_cnt_max n = 1);
             void copyPackedRead(const uint_ps_element_min *packedSequence, uint_reads_cnt_max destIdx,
                     uint_reads_cnt_max n = 1);
+            void addPackedReads(const uint_ps_element_min *packedSequence, uint_reads_cnt_max n = 1);
 
             inline uint_read_len_max minReadLength() { return properties->minReadLength; };
             inline uint_read_len_max maxReadLength() { return properties->maxReadLength; };
@@ -37,6 +41,7 @@ namespace PgSAReadsSet {
 
             inline bool isReadLengthConstant() { return properties->constantReadLength; };
 
+            inline uint_read_len_max getPackedLength() { return packedLength; };
             inline const uint_ps_element_min* getPackedRead(uint_reads_cnt_max i) { return packedReads.data() + i * (size_t) packedLength;};
             inline const string getReadPrefix(uint_reads_cnt_max i, uint_read_len_max skipSuffix) { return sPacker->reverseSequence(packedReads.data() + i * (size_t) packedLength, 0, readLength(i) - skipSuffix);};
             inline void getReadSuffix(char *destPtr, uint_reads_cnt_max i, uint_read_len_max suffixPos) { sPacker->reverseSequence(packedReads.data() + i * (size_t) packedLength, suffixPos, readLength(i) - suffixPos, destPtr);};
@@ -68,6 +73,28 @@ namespace PgSAReadsSet {
             static PackedConstantLengthReadsSet* loadReadsSet(ReadsSourceIterator* readsIterator, ReadsSetProperties* properties = 0);
 
     };
+
+    template < typename uint_read_len >
+    class PackedConstantLengthReadsSetIterator: public ReadsSourceIteratorTemplate< uint_read_len >
+    {
+        private:
+            PackedConstantLengthReadsSet* readsSet;
+            string read;
+            int64_t counter = -1;
+
+        public:
+
+            PackedConstantLengthReadsSetIterator(PackedConstantLengthReadsSet* readsSet);
+
+            ~PackedConstantLengthReadsSetIterator();
+
+            bool moveNext();
+            string getRead();
+            uint_read_len getReadLength();
+            void rewind();
+
+            IndexesMapping* retainVisitedIndexesMapping() override;
+    };
 }
 
 #endif // PACKEDREADSSET_H_INCLUDED
@@ -0,0 +1,29 @@
+#ifndef PGTOOLS_READSINDEXESVECTOR_H
+#define PGTOOLS_READSINDEXESVECTOR_H
+
+#include "../pgsaconfig.h"
+#include "../utils/VariableWidthVector.h"
+
+namespace PgSAReadsSet {
+
+    // Reads indexes stored as uint_reads_cnt_std until an index (or declared reads count)
+    // exceeds its range, then as uint_reads_cnt_max.
+    class ReadsIndexesVector: public PgSAHelpers::VariableWidthVector<uint_reads_cnt_std, uint_reads_cnt_max> {
+    public:
+        ReadsIndexesVector() {}
+
+        explicit ReadsIndexesVector(uint_reads_cnt_max readsTotalCount) {
+            fitReadsCount(readsTotalCount);
+        }
+
+        ReadsIndexesVector(vector<uint_reads_cnt_std> &&idxs): VariableWidthVector(std::move(idxs)) {}
+
+        void fitReadsCount(uint_reads_cnt_max readsTotalCount) {
+            if (!isReadsCountStd(readsTotalCount))
+                useWideValues();
+        }
+    };
+
+}
+
+#endif //PGTOOLS_READSINDEXESVECTOR_H
@@ -2,10 +2,86 @@
 
 #include "../../utils/helper.h"
 
+#ifdef X86_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
 using namespace PgSAHelpers;
 
 namespace PgTools {
 
+    // Per-symbol log-probabilities of a correct base call in fixed point (2^24 units).
+    // Symbols outside the Phred range have probability 1 (log 0); '!' (probability 0) is flagged separately.
+    static const double QUALITY_LOG_PROB_SCALE = 1 << 24;
+    static const char ZERO_PROB_QUALITY_SYMBOL = 33;
+    // exp(-700) stays well above DBL_MIN, so the exact product cannot underflow above this sum
+    static const int64_t MIN_SAFE_LOG_PROB_SUM = -700 * (int64_t) QUALITY_LOG_PROB_SCALE;
+    // fast decision is taken only beyond this distance from the threshold:
+    // LUT rounding is at most half a unit per symbol, the slack covers floating-point errors of the exact check
+    static const int64_t LOG_PROB_SUM_SLACK = 64;
+
+    struct QualityLogProbLUT {
+        int32_t value[256];
+
+        QualityLogProbLUT() {
+            for (int c = 0; c < 256; c++) {
+                double prob = qualityScore2correctProb(string(1, (char) c));
+                value[c] = prob > 0 ? (int32_t) llround(log(prob) * QUALITY_LOG_PROB_SCALE) : 0;
+            }
+        }
+    };
+
+    static const int32_t* getQualityLogProbLUT() {
+        static const QualityLogProbLUT lut;
+        return lut.value;
+    }
+
+    static int64_t sumQualityLogProbsScalar(const uint8_t* quality, size_t length, const int32_t* lut,
+            bool &zeroProb) {
+        int64_t sum = 0;
+        for (size_t i = 0; i < length; i++) {
+            zeroProb |= quality[i] == ZERO_PROB_QUALITY_SYMBOL;
+            sum += lut[quality[i]];
+        }
+        return sum;
+    }
+
+#ifdef X86_SIMD_DISPATCH
+    __attribute__((target("avx2")))
+    static int64_t sumQualityLogProbsAVX2(const uint8_t* quality, size_t length, const int32_t* lut,
+            bool &zeroProb) {
+        const __m256i zeroProbSymbol = _mm256_set1_epi8(ZERO_PROB_QUALITY_SYMBOL);
+        __m256i zeroProbMask = _mm256_setzero_si256();
+        __m256i sum64 = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            const __m256i symbols = _mm256_loadu_si256((const __m256i*) (quality + i));
+            zeroProbMask = _mm256_or_si256(zeroProbMask, _mm256_cmpeq_epi8(symbols, zeroProbSymbol));
+            __m256i sum32 = _mm256_setzero_si256();
+            for (size_t j = 0; j < 32; j += 8) {
+                const __m256i idxs = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) (quality + i + j)));
+                sum32 = _mm256_add_epi32(sum32, _mm256_i32gather_epi32(lut, idxs, 4));
+            }
+            sum64 = _mm256_add_epi64(sum64, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(sum32)));
+            sum64 = _mm256_add_epi64(sum64, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(sum32, 1)));
+        }
+        zeroProb |= !_mm256_testz_si256(zeroProbMask, zeroProbMask);
+        int64_t lanes[4];
+        _mm256_storeu_si256((__m256i*) lanes, sum64);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+               sumQualityLogProbsScalar(quality + i, length - i, lut, zeroProb);
+    }
+#endif
+
+    static int64_t sumQualityLogProbs(const string &quality, bool &zeroProb) {
+        const uint8_t* symbols = (const uint8_t*) quality.data();
+#ifdef X86_SIMD_DISPATCH
+        if (isAVX2Supported())
+            return sumQualityLogProbsAVX2(symbols, quality.length(), getQualityLogProbLUT(), zeroProb);
+#endif
+        return sumQualityLogProbsScalar(symbols, quality.length(), getQualityLogProbLUT(), zeroProb);
+    }
+
     template<typename uint_read_len>
     QualityDividingReadsSetIterator<uint_read_len>::QualityDividingReadsSetIterator(
             ReadsSourceIteratorTemplate<uint_read_len> *coreIterator, double error_level)
@@ -26,7 +102,22 @@ namespace PgTools {
 
     template<typename uint_read_len>
     bool QualityDividingReadsSetIterator<uint_read_len>::isQualityHigh() {
-        return (1 - qualityScore2correctProb(getQualityInfo()) <= error_level);
+        return isQualityHigh(getQualityInfo(), error_level);
+    }
+
+    template<typename uint_read_len>
+    bool QualityDividingReadsSetIterator<uint_read_len>::isQualityHigh(const string &quality, double error_level) {
+        // geometric mean of probabilities >= 1 - error_level  <=>  sum of log-probabilities >= length * log(1 - error_level);
+        // reads close to the threshold (or with possible underflow) are resolved by the exact product
+        if (!quality.empty() && error_level < 1) {
+            bool zeroProb = false;
+            const int64_t logProbSum = sumQualityLogProbs(quality, zeroProb);
+            const double threshold = quality.length() * log(1 - error_level) * QUALITY_LOG_PROB_SCALE;
+            const double margin = (double) quality.length() + LOG_PROB_SUM_SLACK;
+            if (!zeroProb && logProbSum > MIN_SAFE_LOG_PROB_SUM && fabs(logProbSum - threshold) > margin)
+                return logProbSum > threshold;
+        }
+        return (1 - qualityScore2correctProb(quality) <= error_level);
     }
 
     template<typename uint_read_len>
@@ -29,6 +29,8 @@ namespace PgTools {
         bool isQualityHigh();
         bool containsN();
 
+        static bool isQualityHigh(const string &quality, double error_level);
+
         IndexesMapping* retainVisitedIndexesMapping() override;
     };
 
@@ -44,7 +46,7 @@ namespace PgTools {
         bool ignoreNoNReads;
         bool plainTextReadMode = false;
 
-        vector<uint_reads_cnt_max> indexesMapping;
+        ReadsIndexesVector indexesMapping;
         bool isIgnored();
     public:
         DividedReadsSetIterator(ReadsSourceIteratorTemplate<uint_read_len> *coreIterator, std::istream* divSource,
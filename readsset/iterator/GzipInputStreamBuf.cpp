@@ -0,0 +1,243 @@
+#include "GzipInputStreamBuf.h"
+
+namespace PgSAReadsSet {
+
+    using namespace PgSAHelpers;
+
+    static const uint8_t GZIP_ID1 = GzipInputStreamBuf::GZIP_MAGIC_FIRST_BYTE;
+    static const uint8_t GZIP_ID2 = 0x8b;
+    static const uint8_t GZIP_FLG_FEXTRA = 4;
+    static const size_t GZIP_HEADER_LENGTH = 12;
+    static const size_t GZIP_TRAILER_LENGTH = 8;
+
+    bool GzipInputStreamBuf::isGzipFile(const string &srcFile) {
+        std::ifstream in(srcFile, ios_base::in | ios_base::binary);
+        uint8_t magic[2] = { 0 };
+        in.read((char*) magic, 2);
+        return in.gcount() == 2 && magic[0] == GZIP_ID1 && magic[1] == GZIP_ID2;
+    }
+
+    GzipInputStreamBuf::GzipInputStreamBuf(const string &srcFile) {
+        src = new std::ifstream(srcFile, ios_base::in | ios_base::binary);
+        if (src->fail()) {
+            fprintf(stderr, "cannot open reads file %s\n", srcFile.c_str());
+            exit(EXIT_FAILURE);
+        }
+        vector<char> block;
+        bgzfMode = readBgzfBlock(block);
+        src->clear();
+        src->seekg(0);
+        startInflating();
+    }
+
+    GzipInputStreamBuf::GzipInputStreamBuf(std::streambuf* srcStreamBuf) {
+        src = new std::istream(srcStreamBuf);
+        ownedSrcBuf = srcStreamBuf;
+        seekable = false;
+        bgzfMode = false;
+        startInflating();
+    }
+
+    GzipInputStreamBuf::~GzipInputStreamBuf() {
+        stopInflating();
+        delete(src);
+        delete(ownedSrcBuf);
+    }
+
+    void GzipInputStreamBuf::startInflating() {
+        setg(0, 0, 0);
+        if (bgzfMode) {
+            inflaterDone = false;
+            stopInflater = false;
+            inflater = std::thread(&GzipInputStreamBuf::inflateBgzfBlocks, this);
+        } else {
+            strm = z_stream();
+            if (inflateInit2(&strm, 15 + 16) != Z_OK) {
+                fprintf(stderr, "Error initializing gzip decompression.\n");
+                exit(EXIT_FAILURE);
+            }
+            inBuf.resize(STREAM_BUFFER_SIZE);
+            outBuf.resize(STREAM_BUFFER_SIZE);
+            streamEnd = false;
+            memberOpen = false;
+        }
+    }
+
+    void GzipInputStreamBuf::stopInflating() {
+        if (bgzfMode) {
+            {
+                std::lock_guard<std::mutex> lock(mut);
+                stopInflater = true;
+            }
+            ringCond.notify_all();
+            if (inflater.joinable())
+                inflater.join();
+            ring.clear();
+        } else
+            inflateEnd(&strm);
+    }
+
+    // returns false at the end of file or if the gzip member is not a BGZF block
+    bool GzipInputStreamBuf::readBgzfBlock(vector<char> &block) {
+        block.resize(GZIP_HEADER_LENGTH);
+        src->read(block.data(), GZIP_HEADER_LENGTH);
+        if (src->gcount() != GZIP_HEADER_LENGTH)
+            return false;
+        const uint8_t* header = (uint8_t*) block.data();
+        if (header[0] != GZIP_ID1 || header[1] != GZIP_ID2 || !(header[3] & GZIP_FLG_FEXTRA))
+            return false;
+        const uint16_t xlen = header[10] | (header[11] << 8);
+        block.resize(GZIP_HEADER_LENGTH + xlen);
+        src->read(block.data() + GZIP_HEADER_LENGTH, xlen);
+        if (src->gcount() != xlen)
+            return false;
+        size_t blockSize = 0;
+        const uint8_t* extra = (uint8_t*) block.data() + GZIP_HEADER_LENGTH;
+        for (uint16_t i = 0; i + 4 <= xlen; i += 4 + (extra[i + 2] | (extra[i + 3] << 8))) {
+            if (extra[i] == 'B' && extra[i + 1] == 'C' && extra[i + 2] == 2 && extra[i + 3] == 0 && i + 6 <= xlen) {
+                blockSize = (extra[i + 4] | (extra[i + 5] << 8)) + 1;
+                break;
+            }
+        }
+        if (blockSize < GZIP_HEADER_LENGTH + xlen + GZIP_TRAILER_LENGTH)
+            return false;
+        const size_t headerLength = block.size();
+        block.resize(blockSize);
+        src->read(block.data() + headerLength, blockSize - headerLength);
+        return src->gcount() == blockSize - headerLength;
+    }
+
+    void GzipInputStreamBuf::inflateBgzfBlock(const vector<char> &block, vector<char> &out) {
+        const uint8_t* isizePtr = (uint8_t*) block.data() + block.size() - 4;
+        const uint32_t isize = isizePtr[0] | (isizePtr[1] << 8) | (isizePtr[2] << 16) | ((uint32_t) isizePtr[3] << 24);
+        out.resize(isize);
+        char dummy;
+        z_stream s = z_stream();
+        inflateInit2(&s, 15 + 16);
+        s.next_in = (Bytef*) block.data();
+        s.avail_in = block.size();
+        s.next_out = (Bytef*) (isize ? out.data() : &dummy);
+        s.avail_out = isize;
+        const int ret = inflate(&s, Z_FINISH);
+        inflateEnd(&s);
+        if (ret != Z_STREAM_END) {
+            fprintf(stderr, "Error decompressing BGZF block (code %d).\n", ret);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    void GzipInputStreamBuf::inflateBgzfBlocks() {
+        const int64_t batchSize = BGZF_BLOCKS_PER_THREAD * numberOfThreads;
+        vector<vector<char>> blocks(batchSize);
+        vector<vector<char>> outs(batchSize);
+        while (true) {
+            int64_t blocksCount = 0;
+            while (blocksCount < batchSize && readBgzfBlock(blocks[blocksCount]))
+                blocksCount++;
+            if (blocksCount < batchSize && (src->gcount() != 0 || !src->eof())) {
+                fprintf(stderr, "Error: unsupported or truncated gzip member in BGZF file.\n");
+                exit(EXIT_FAILURE);
+            }
+            if (blocksCount == 0)
+                break;
+            #pragma omp parallel for num_threads(numberOfThreads) schedule(dynamic)
+            for (int64_t i = 0; i < blocksCount; i++)
+                inflateBgzfBlock(blocks[i], outs[i]);
+            size_t batchLength = 0;
+            for (int64_t i = 0; i < blocksCount; i++)
+                batchLength += outs[i].size();
+            vector<char> batch;
+            batch.reserve(batchLength);
+            for (int64_t i = 0; i < blocksCount; i++)
+                batch.insert(batch.end(), outs[i].begin(), outs[i].end());
+
+            std::unique_lock<std::mutex> lock(mut);
+            ringCond.wait(lock, [this] { return ring.size() < BGZF_RING_SIZE || stopInflater; });
+            if (stopInflater)
+                return;
+            ring.push_back(std::move(batch));
+            lock.unlock();
+            ringCond.notify_all();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mut);
+            inflaterDone = true;
+        }
+        ringCond.notify_all();
+    }
+
+    bool GzipInputStreamBuf::underflowBgzf() {
+        std::unique_lock<std::mutex> lock(mut);
+        do {
+            ringCond.wait(lock, [this] { return !ring.empty() || inflaterDone; });
+            if (ring.empty())
+                return false;
+            outBuf = std::move(ring.front());
+            ring.pop_front();
+        } while (outBuf.empty());
+        lock.unlock();
+        ringCond.notify_all();
+        setg(outBuf.data(), outBuf.data(), outBuf.data() + outBuf.size());
+        return true;
+    }
+
+    bool GzipInputStreamBuf::underflowStream() {
+        while (!streamEnd) {
+            if (strm.avail_in == 0) {
+                src->read(inBuf.data(), STREAM_BUFFER_SIZE);
+                strm.next_in = (Bytef*) inBuf.data();
+                strm.avail_in = src->gcount();
+                if (strm.avail_in == 0 && !memberOpen) {
+                    streamEnd = true;
+                    break;
+                }
+            }
+            if (strm.avail_in)
+                memberOpen = true;
+            strm.next_out = (Bytef*) outBuf.data();
+            strm.avail_out = STREAM_BUFFER_SIZE;
+            const int ret = inflate(&strm, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END) {
+                inflateReset(&strm);
+                memberOpen = false;
+            } else if (ret == Z_BUF_ERROR && strm.avail_in == 0) {
+                fprintf(stderr, "Error: truncated gzip stream.\n");
+                exit(EXIT_FAILURE);
+            } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                fprintf(stderr, "Error decompressing gzip stream (code %d).\n", ret);
+                exit(EXIT_FAILURE);
+            }
+            const size_t outLength = STREAM_BUFFER_SIZE - strm.avail_out;
+            if (outLength) {
+                setg(outBuf.data(), outBuf.data(), outBuf.data() + outLength);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    GzipInputStreamBuf::int_type GzipInputStreamBuf::underflow() {
+        if (gptr() < egptr())
+            return traits_type::to_int_type(*gptr());
+        if (!(bgzfMode ? underflowBgzf() : underflowStream()))
+            return traits_type::eof();
+        return traits_type::to_int_type(*gptr());
+    }
+
+    // only rewinding to the beginning of the stream is supported
+    GzipInputStreamBuf::pos_type GzipInputStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                             std::ios_base::openmode which) {
+        if (!seekable || off != 0 || dir != std::ios_base::beg)
+            return pos_type(off_type(-1));
+        stopInflating();
+        src->clear();
+        src->seekg(0);
+        startInflating();
+        return pos_type(0);
+    }
+
+    GzipInputStreamBuf::pos_type GzipInputStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which) {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+}
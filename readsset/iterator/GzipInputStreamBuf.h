@@ -0,0 +1,74 @@
+#ifndef PGTOOLS_GZIPINPUTSTREAMBUF_H
+#define PGTOOLS_GZIPINPUTSTREAMBUF_H
+
+#include <streambuf>
+#include <fstream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <zlib.h>
+
+#include "../../utils/helper.h"
+
+namespace PgSAReadsSet {
+
+    // Decompresses gzip input. BGZF files (series of independent gzip members)
+    // are inflated in batches of blocks on numberOfThreads workers into an ordered ring of buffers;
+    // other gzip files are inflated by a single-threaded stream.
+    class GzipInputStreamBuf: public std::streambuf {
+    private:
+        static const size_t STREAM_BUFFER_SIZE = 1 << 20;
+        static const size_t BGZF_BLOCKS_PER_THREAD = 16;
+        static const size_t BGZF_RING_SIZE = 4;
+
+        std::istream* src;
+        std::streambuf* ownedSrcBuf = 0;
+        bool seekable = true;
+        bool bgzfMode;
+        vector<char> outBuf;
+
+        z_stream strm;
+        vector<char> inBuf;
+        bool streamEnd = false;
+        // input of a gzip member was consumed before its end was reached
+        bool memberOpen = false;
+
+        std::thread inflater;
+        std::mutex mut;
+        std::condition_variable ringCond;
+        std::deque<vector<char>> ring;
+        bool inflaterDone = false;
+        bool stopInflater = false;
+
+        void startInflating();
+        void stopInflating();
+
+        bool readBgzfBlock(vector<char> &block);
+        static void inflateBgzfBlock(const vector<char> &block, vector<char> &out);
+        void inflateBgzfBlocks();
+
+        bool underflowStream();
+        bool underflowBgzf();
+
+    protected:
+        int_type underflow() override;
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+    public:
+        GzipInputStreamBuf(const string &srcFile);
+        // takes ownership of a non-seekable source (e.g. a pipe); the input is inflated as a plain gzip stream
+        GzipInputStreamBuf(std::streambuf* srcStreamBuf);
+
+        virtual ~GzipInputStreamBuf();
+
+        static const uint8_t GZIP_MAGIC_FIRST_BYTE = 0x1f;
+
+        static bool isGzipFile(const string &srcFile);
+    };
+
+}
+
+#endif //PGTOOLS_GZIPINPUTSTREAMBUF_H
@@ -0,0 +1,159 @@
+#include "ReadAheadInputStreamBuf.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <cerrno>
+
+namespace PgSAReadsSet {
+
+    ReadAheadInputStreamBuf::ReadAheadInputStreamBuf(const string &srcFile): srcFile(srcFile) {
+        fd = open(srcFile.c_str(), O_RDONLY);
+        if (fd == -1) {
+            fprintf(stderr, "cannot open reads file %s\n", srcFile.c_str());
+            exit(EXIT_FAILURE);
+        }
+        seekable = lseek(fd, 0, SEEK_CUR) != -1;
+#ifdef POSIX_FADV_SEQUENTIAL
+        if (seekable)
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        startReading();
+    }
+
+    ReadAheadInputStreamBuf::~ReadAheadInputStreamBuf() {
+        stopReading();
+        close(fd);
+    }
+
+    void ReadAheadInputStreamBuf::startReading() {
+        setg(0, 0, 0);
+        readerDone = false;
+        stopReader = false;
+        readFailed = false;
+        if (pipe(stopPipe) == -1) {
+            fprintf(stderr, "cannot create pipe for reading %s\n", srcFile.c_str());
+            exit(EXIT_FAILURE);
+        }
+        reader = std::thread(&ReadAheadInputStreamBuf::readBlocks, this);
+    }
+
+    void ReadAheadInputStreamBuf::stopReading() {
+        {
+            std::lock_guard<std::mutex> lock(mut);
+            stopReader = true;
+        }
+        blocksCond.notify_all();
+        // wakes up the reader blocked on a pipe that is not at its end yet
+        while (write(stopPipe[1], "", 1) == -1 && errno == EINTR);
+        if (reader.joinable())
+            reader.join();
+        close(stopPipe[0]);
+        close(stopPipe[1]);
+        for (Block &block: blocks)
+            freeBlocks.push_back(std::move(block));
+        blocks.clear();
+        if (curBlock.data)
+            freeBlocks.push_back(std::move(curBlock));
+    }
+
+    void ReadAheadInputStreamBuf::readBlocks() {
+        while (true) {
+            Block block;
+            {
+                std::unique_lock<std::mutex> lock(mut);
+                blocksCond.wait(lock, [this] { return blocks.size() < READ_AHEAD_BLOCKS || stopReader; });
+                if (stopReader)
+                    return;
+                if (!freeBlocks.empty()) {
+                    block = std::move(freeBlocks.back());
+                    freeBlocks.pop_back();
+                }
+            }
+            if (!block.data)
+                block.data.reset(new char[BLOCK_SIZE]);
+            if (!readBlock(block)) {
+                std::lock_guard<std::mutex> lock(mut);
+                readFailed = !stopReader;
+                readerDone = true;
+                blocksCond.notify_all();
+                return;
+            }
+            const bool endOfFile = block.length < BLOCK_SIZE;
+            {
+                std::lock_guard<std::mutex> lock(mut);
+                if (stopReader)
+                    return;
+                if (block.length)
+                    blocks.push_back(std::move(block));
+                readerDone = endOfFile;
+            }
+            blocksCond.notify_all();
+            if (endOfFile)
+                return;
+        }
+    }
+
+    // returns false on read error or when interrupted by stopReading
+    bool ReadAheadInputStreamBuf::readBlock(Block &block) {
+        block.length = 0;
+        pollfd fds[2] = {{fd, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+        while (block.length < BLOCK_SIZE) {
+            if (!seekable) {
+                if (poll(fds, 2, -1) == -1) {
+                    if (errno == EINTR)
+                        continue;
+                    return false;
+                }
+                if (fds[1].revents)
+                    return false;
+            }
+            ssize_t res = read(fd, block.data.get() + block.length, BLOCK_SIZE - block.length);
+            if (res == -1 && errno == EINTR)
+                continue;
+            if (res == -1)
+                return false;
+            if (res == 0)
+                break;
+            block.length += res;
+        }
+        return true;
+    }
+
+    ReadAheadInputStreamBuf::int_type ReadAheadInputStreamBuf::underflow() {
+        if (gptr() < egptr())
+            return traits_type::to_int_type(*gptr());
+        std::unique_lock<std::mutex> lock(mut);
+        if (curBlock.data)
+            freeBlocks.push_back(std::move(curBlock));
+        blocksCond.wait(lock, [this] { return !blocks.empty() || readerDone; });
+        if (blocks.empty() && readFailed) {
+            fprintf(stderr, "Error reading reads file %s.\n", srcFile.c_str());
+            exit(EXIT_FAILURE);
+        }
+        if (blocks.empty())
+            return traits_type::eof();
+        curBlock = std::move(blocks.front());
+        blocks.pop_front();
+        lock.unlock();
+        blocksCond.notify_all();
+        setg(curBlock.data.get(), curBlock.data.get(), curBlock.data.get() + curBlock.length);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    // only rewinding to the beginning of a seekable file is supported
+    ReadAheadInputStreamBuf::pos_type ReadAheadInputStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                                       std::ios_base::openmode which) {
+        if (!seekable || off != 0 || dir != std::ios_base::beg)
+            return pos_type(off_type(-1));
+        stopReading();
+        lseek(fd, 0, SEEK_SET);
+        startReading();
+        return pos_type(0);
+    }
+
+    ReadAheadInputStreamBuf::pos_type ReadAheadInputStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which) {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+}
@@ -0,0 +1,61 @@
+#ifndef PGTOOLS_READAHEADINPUTSTREAMBUF_H
+#define PGTOOLS_READAHEADINPUTSTREAMBUF_H
+
+#include <streambuf>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../../utils/helper.h"
+
+namespace PgSAReadsSet {
+
+    // Reads a file (or a pipe) sequentially in large blocks on a background thread (double buffering),
+    // so that parsing of interleaved sources (e.g. paired-end files) never waits on I/O of either of them.
+    class ReadAheadInputStreamBuf: public std::streambuf {
+    private:
+        static const size_t BLOCK_SIZE = 16 << 20;
+        static const size_t READ_AHEAD_BLOCKS = 1;
+
+        struct Block {
+            std::unique_ptr<char[]> data;
+            size_t length = 0;
+        };
+
+        const string srcFile;
+        int fd;
+        bool seekable;
+        int stopPipe[2];
+        Block curBlock;
+
+        std::thread reader;
+        std::mutex mut;
+        std::condition_variable blocksCond;
+        std::deque<Block> blocks;
+        vector<Block> freeBlocks;
+        bool readerDone = false;
+        bool stopReader = false;
+        bool readFailed = false;
+
+        void startReading();
+        void stopReading();
+        void readBlocks();
+        bool readBlock(Block &block);
+
+    protected:
+        int_type underflow() override;
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+    public:
+        ReadAheadInputStreamBuf(const string &srcFile);
+
+        virtual ~ReadAheadInputStreamBuf();
+    };
+
+}
+
+#endif //PGTOOLS_READAHEADINPUTSTREAMBUF_H
@@ -1,5 +1,10 @@
 #include "ReadsSetIterator.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace PgSAReadsSet {
 
     using namespace PgSAHelpers;
@@ -12,8 +17,8 @@ namespace PgSAReadsSet {
         }
         writeReadMode(mappingDest, PgSAHelpers::plainTextWriteMode);
         writeValue(mappingDest, readsCount);
-        for(uint_reads_cnt_max orgIdx: this->mappingWithGuard) {
-            writeValue(mappingDest, orgIdx);
+        for(size_t i = 0; i < this->mappingWithGuard.size(); i++) {
+            writeValue(mappingDest, this->mappingWithGuard[i]);
         }
         writeValue(mappingDest, readsCount);
         mappingDest.close();
@@ -28,7 +33,7 @@ namespace PgSAReadsSet {
         bool plainTextReadMode = confirmTextReadMode(*divSource);
         uint_reads_cnt_max readsCount;
         readValue(*divSource, readsCount, plainTextReadMode);
-        VectorMapping* mapping = new VectorMapping({}, readsCount);
+        VectorMapping* mapping = new VectorMapping(ReadsIndexesVector(readsCount), readsCount);
         uint_reads_cnt_max orgIdx = 0;
         do {
             readValue(*divSource, orgIdx, plainTextReadMode);
@@ -38,7 +43,7 @@ namespace PgSAReadsSet {
         return mapping;
     }
 
-    vector<uint_reads_cnt_max> &VectorMapping::getMappingVector() {
+    ReadsIndexesVector &VectorMapping::getMappingVector() {
         return mappingWithGuard;
     }
 
@@ -66,9 +71,7 @@ namespace PgSAReadsSet {
         if (!std::getline(*source, line)) 
             return false;
 
-        for (length = 0; length < line.length(); length++)
-            if (!isalpha(line[length]))
-                break;
+        length = scanReadLength<uint_read_len>(line.data(), line.data() + line.length());
 
         counter++;
         return true;
@@ -123,9 +126,7 @@ namespace PgSAReadsSet {
                 return false;
         } while (line[0] == '>' || line[0] == ';');
             
-        for (length = 0; length < line.length(); length++)
-            if (!isalpha(line[length]))
-                break;
+        length = scanReadLength<uint_read_len>(line.data(), line.data() + line.length());
 
         counter++;
         return true;
@@ -166,7 +167,7 @@ namespace PgSAReadsSet {
     }
 
     template<typename uint_read_len>
-    FASTQReadsSourceIterator<uint_read_len>::FASTQReadsSourceIterator(std::ifstream* source, std::ifstream* pairSource) {
+    FASTQReadsSourceIterator<uint_read_len>::FASTQReadsSourceIterator(std::istream* source, std::istream* pairSource) {
         ownStreams = false;
         this->source = source;
         this->pairSource = pairSource;
@@ -175,9 +176,6 @@ namespace PgSAReadsSet {
     template<typename uint_read_len>
     FASTQReadsSourceIterator<uint_read_len>::~FASTQReadsSourceIterator() {
         if (ownStreams) {
-            source->close();
-            if (pairSource)
-                pairSource->close();
             delete(source);
             delete(pairSource);
         }
@@ -211,9 +209,7 @@ namespace PgSAReadsSet {
         std::getline(*src, opt_id);
         std::getline(*src, quality);
 
-        for (length = 0; length < line.length(); length++)
-            if (!isalpha(line[length]))
-                break;
+        length = scanReadLength<uint_read_len>(line.data(), line.data() + line.length());
 
         counter++;
         return true;
@@ -238,6 +234,101 @@ namespace PgSAReadsSet {
     }
 
 
+    void MappedReadsFile::map(const string &file, int advice) {
+        int fd = open(file.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd == -1 || fstat(fd, &st) == -1) {
+            fprintf(stderr, "cannot open reads file %s\n", file.c_str());
+            exit(EXIT_FAILURE);
+        }
+        size = st.st_size;
+        if (size > 0) {
+            void* addr = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                fprintf(stderr, "cannot map reads file %s\n", file.c_str());
+                exit(EXIT_FAILURE);
+            }
+            madvise(addr, size, advice);
+            data = (const char*) addr;
+        }
+        close(fd);
+        pos = data;
+    }
+
+    void MappedReadsFile::unmap() {
+        if (data)
+            munmap((void*) data, size);
+        data = 0;
+        pos = 0;
+        size = 0;
+    }
+
+    template<typename uint_read_len>
+    MmapFASTQReadsSourceIterator<uint_read_len>::MmapFASTQReadsSourceIterator(const string &srcFile,
+            const string &pairFile) {
+        source.map(srcFile, MADV_SEQUENTIAL);
+        if (pairFile != "") {
+            pairSource.map(pairFile, MADV_SEQUENTIAL);
+            isPaired = true;
+        }
+    }
+
+    template<typename uint_read_len>
+    MmapFASTQReadsSourceIterator<uint_read_len>::~MmapFASTQReadsSourceIterator() {
+        source.unmap();
+        if (isPaired)
+            pairSource.unmap();
+    }
+
+    template<typename uint_read_len>
+    string MmapFASTQReadsSourceIterator<uint_read_len>::getRead() {
+        return string(readPtr, length);
+    }
+
+    template<typename uint_read_len>
+    string MmapFASTQReadsSourceIterator<uint_read_len>::getQualityInfo() {
+        return string(qualityPtr, qualityLength);
+    }
+
+    template<typename uint_read_len>
+    uint_read_len MmapFASTQReadsSourceIterator<uint_read_len>::getReadLength() {
+        return length;
+    }
+
+    template<typename uint_read_len>
+    bool MmapFASTQReadsSourceIterator<uint_read_len>::moveNext() {
+        MappedReadsFile &src = (pair && isPaired) ? pairSource : source;
+        pair = !pair;
+
+        if (src.pos == src.end())
+            return false;
+        const char* lineEnd;
+        src.nextLine(lineEnd);
+        readPtr = src.nextLine(lineEnd);
+        const char* readEnd = lineEnd;
+        src.nextLine(lineEnd);
+        qualityPtr = src.nextLine(lineEnd);
+
+        length = scanReadLength<uint_read_len>(readPtr, readEnd);
+        qualityLength = lineEnd - qualityPtr < length ? lineEnd - qualityPtr : length;
+
+        counter++;
+        return true;
+    }
+
+    template<typename uint_read_len>
+    void MmapFASTQReadsSourceIterator<uint_read_len>::rewind() {
+        counter = -1;
+        source.pos = source.data;
+        pairSource.pos = pairSource.data;
+        pair = false;
+    }
+
+    template<typename uint_read_len>
+    IndexesMapping* MmapFASTQReadsSourceIterator<uint_read_len>::retainVisitedIndexesMapping() {
+        return new DirectMapping(counter + 1);
+    }
+
     template<typename uint_read_len>
     ReadsSourceIteratorTemplate<uint_read_len>::~ReadsSourceIteratorTemplate() {
     }
@@ -349,6 +440,8 @@ namespace PgSAReadsSet {
     template class FASTAReadsSourceIterator<uint_read_len_std>;
     template class FASTQReadsSourceIterator<uint_read_len_min>;
     template class FASTQReadsSourceIterator<uint_read_len_std>;
+    template class MmapFASTQReadsSourceIterator<uint_read_len_min>;
+    template class MmapFASTQReadsSourceIterator<uint_read_len_std>;
     template class RevComplPairReadsSetIterator<uint_read_len_min>;
     template class RevComplPairReadsSetIterator<uint_read_len_std>;
     template class IgnoreNReadsSetIterator<uint_read_len_min>;
@@ -2,15 +2,31 @@
 #define READSSETITERATOR_H_INCLUDED
 
 #include <ctype.h>
+#include <cstdio>
 #include <iostream>
 #include <vector>
 #include "../../utils/helper.h"
 #include "../../pgsaconfig.h"
+#include "../ReadsIndexesVector.h"
 
 namespace PgSAReadsSet {
 
     typedef uint_read_len_std uint_read_len_max;
 
+    // number of leading letters (read symbols) in [read, end)
+    template<typename uint_read_len>
+    inline uint_read_len scanReadLength(const char* read, const char* end) {
+        size_t length = 0;
+        while (read + length < end && isalpha(read[length]))
+            length++;
+        if (length > (uint_read_len) -1) {
+            fprintf(stderr, "Unsupported read length: %zu (reads up to %d bases are supported).\n",
+                    length, (int) (uint_read_len) -1);
+            exit(EXIT_FAILURE);
+        }
+        return length;
+    }
+
     class IndexesMapping {
     public:
         virtual uint_reads_cnt_max getReadOriginalIndex(uint_reads_cnt_max idx) = 0;
@@ -31,11 +47,12 @@ namespace PgSAReadsSet {
 
     class VectorMapping : public IndexesMapping {
     private:
-        vector<uint_reads_cnt_max> mappingWithGuard;
+        ReadsIndexesVector mappingWithGuard;
         uint_reads_cnt_max readsCount;
     public:
-        VectorMapping(vector<uint_reads_cnt_max> &&mapping, uint_reads_cnt_max readsCount) :
+        VectorMapping(ReadsIndexesVector &&mapping, uint_reads_cnt_max readsCount) :
         mappingWithGuard(std::move(mapping)), readsCount(readsCount) {
+            mappingWithGuard.fitReadsCount(readsCount);
             if (mappingWithGuard.empty() || mappingWithGuard.back() != readsCount)
                 mappingWithGuard.push_back(readsCount);
         }
@@ -44,7 +61,7 @@ namespace PgSAReadsSet {
         uint_reads_cnt_max getMappedReadsCount() override { return mappingWithGuard.size() - 1; }
         uint_reads_cnt_max getReadsTotalCount() override { return readsCount; }
 
-        vector<uint_reads_cnt_max> &getMappingVector();
+        ReadsIndexesVector &getMappingVector();
 
         void saveMapping(string mappingFile);
         static VectorMapping* loadMapping(string mappingFile);
@@ -146,8 +163,8 @@ namespace PgSAReadsSet {
         private:
             std::string id, line, opt_id, quality;
             uint_read_len length;
-            std::ifstream* source = 0;
-            std::ifstream* pairSource = 0;
+            std::istream* source = 0;
+            std::istream* pairSource = 0;
             bool ownStreams = false;
             bool pair = false;
             int64_t counter = -1;
@@ -155,7 +172,7 @@ namespace PgSAReadsSet {
         public:
 
             FASTQReadsSourceIterator(const string &srcFile, const string &pairFile = std::string());
-            FASTQReadsSourceIterator(std::ifstream* source, std::ifstream* pairSource);
+            FASTQReadsSourceIterator(std::istream* source, std::istream* pairSource);
 
             ~FASTQReadsSourceIterator();
 
@@ -168,6 +185,59 @@ namespace PgSAReadsSet {
             IndexesMapping* retainVisitedIndexesMapping() override;
     };
 
+    struct MappedReadsFile {
+        const char* data = 0;
+        size_t size = 0;
+        const char* pos = 0;
+
+        void map(const string &file, int advice);
+        void unmap();
+
+        inline const char* end() const { return data + size; };
+
+        inline const char* nextLine(const char* &lineEnd) {
+            const char* lineBeg = pos;
+            lineEnd = (const char*) memchr(lineBeg, '\n', end() - lineBeg);
+            if (lineEnd)
+                pos = lineEnd + 1;
+            else
+                pos = lineEnd = end();
+            return lineBeg;
+        }
+    };
+
+    template < typename uint_read_len >
+    class MmapFASTQReadsSourceIterator: public ReadsSourceIteratorTemplate< uint_read_len >
+    {
+        private:
+            MappedReadsFile source, pairSource;
+            bool isPaired = false;
+            bool pair = false;
+            const char* readPtr = 0;
+            const char* qualityPtr = 0;
+            uint_read_len length;
+            uint_read_len qualityLength;
+            int64_t counter = -1;
+
+        public:
+
+            MmapFASTQReadsSourceIterator(const string &srcFile, const string &pairFile = std::string());
+
+            ~MmapFASTQReadsSourceIterator();
+
+            bool moveNext();
+            string getRead();
+            string getQualityInfo();
+            uint_read_len getReadLength();
+            void rewind();
+
+            // views into the mapped file (valid until the iterator is destroyed)
+            const char* getReadPtr() { return readPtr; };
+            const char* getQualityPtr() { return qualityPtr; };
+
+            IndexesMapping* retainVisitedIndexesMapping() override;
+    };
+
     template < typename uint_read_len >
     class RevComplPairReadsSetIterator: public ReadsSourceIteratorTemplate< uint_read_len > {
     private:
@@ -190,7 +260,7 @@ namespace PgSAReadsSet {
     private:
         ReadsSourceIteratorTemplate<uint_read_len>* coreIterator;
         int64_t counter = -1;
-        vector<uint_reads_cnt_max> indexesMapping;
+        ReadsIndexesVector indexesMapping;
 
         bool isFreeOfN();
     public:
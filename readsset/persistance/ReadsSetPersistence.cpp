@@ -2,8 +2,17 @@
 
 #include "../iterator/DivisionReadsSetDecorators.h"
 
+#include <sys/stat.h>
+
 namespace PgSAReadsSet {
 
+    const string ReadsSetPersistence::STDIN_SOURCE = "-";
+
+    bool ReadsSetPersistence::isStreamSource(const string &file) {
+        struct stat st;
+        return file == STDIN_SOURCE || (stat(file.c_str(), &st) == 0 && !S_ISREG(st.st_mode));
+    }
+
     ReadsSourceIteratorTemplate<uint_read_len_max> *ReadsSetPersistence::createManagedReadsIterator(const string &srcFile,
                                                                                                     const string &pairFile,
                                                                                                     bool revComplPairFile,
@@ -17,33 +26,46 @@ namespace PgSAReadsSet {
 
     using namespace PgTools;
 
+    istream* ReadsSetPersistence::ManagedReadsSetIterator::openReadsSource(const string &file,
+            std::streambuf* &sourceBuf) {
+        const bool streamSource = isStreamSource(file);
+        if (!streamSource && GzipInputStreamBuf::isGzipFile(file))
+            sourceBuf = new GzipInputStreamBuf(file);
+        else {
+            sourceBuf = new ReadAheadInputStreamBuf(file == STDIN_SOURCE ? "/dev/stdin" : file);
+            if (streamSource && sourceBuf->sgetc() == GzipInputStreamBuf::GZIP_MAGIC_FIRST_BYTE)
+                sourceBuf = new GzipInputStreamBuf(sourceBuf);
+        }
+        return new istream(sourceBuf);
+    }
+
+    static bool isPlainFASTQFile(const string &file) {
+        if (ReadsSetPersistence::isStreamSource(file) || GzipInputStreamBuf::isGzipFile(file))
+            return false;
+        ifstream source(file, ios_base::in | ios_base::binary);
+        return source.peek() == '@';
+    }
+
     ReadsSetPersistence::ManagedReadsSetIterator::ManagedReadsSetIterator(const string &srcFile, const string &pairFile,
             bool revComplPairFile, const string &divisionFile, bool divisionComplement, bool ignoreNReads, bool ignoreNoNReads) {
-        srcSource = new ifstream(srcFile, ios_base::in | ios_base::binary);
-        if (srcSource->fail()) {
-            fprintf(stderr, "cannot open reads file %s\n", srcFile.c_str());
-            exit(EXIT_FAILURE);
-        }
-        if (pairFile != "") {
-            pairSource = new ifstream(pairFile, ios_base::in | ios_base::binary);
-            if (pairSource->fail()) {
-                fprintf(stderr, "cannot open reads pair file %s\n", pairFile.c_str());
-                exit(EXIT_FAILURE);
+        if (isPlainFASTQFile(srcFile) && (pairFile == "" || isPlainFASTQFile(pairFile)))
+            readsIterator = new MmapFASTQReadsSourceIterator<uint_read_len_max>(srcFile, pairFile);
+        else {
+            srcSource = openReadsSource(srcFile, srcBuf);
+            if (pairFile != "")
+                pairSource = openReadsSource(pairFile, pairBuf);
+            switch (srcSource->peek()) {
+                case '@':
+                    readsIterator = new FASTQReadsSourceIterator<uint_read_len_max>(srcSource, pairSource);
+                    break;
+                case ';':
+                case '>':
+                    readsIterator = new FASTAReadsSourceIterator<uint_read_len_max>(srcSource, pairSource);
+                    break;
+                default:
+                    readsIterator = new ConcatenatedReadsSourceIterator<uint_read_len_max>(srcSource);
             }
         }
-        char firstSymbol = srcSource->get();
-        srcSource->clear();
-        srcSource->seekg(0);
-        switch(firstSymbol) {
-            case '@': readsIterator = new FASTQReadsSourceIterator<uint_read_len_max>(srcSource, pairSource);
-                break;
-            case ';':
-            case '>':
-                readsIterator = new FASTAReadsSourceIterator<uint_read_len_max>(srcSource, pairSource);
-                break;
-            default:
-                readsIterator = new ConcatenatedReadsSourceIterator<uint_read_len_max>(srcSource);
-        }
         if ((pairFile != "") && revComplPairFile) {
             coreIterators.push_back(readsIterator);
             readsIterator = new RevComplPairReadsSetIterator<uint_read_len_max>(readsIterator);
@@ -65,13 +87,12 @@ namespace PgSAReadsSet {
         delete(readsIterator);
         for(ReadsSourceIteratorTemplate<uint_read_len_max>* coreIterator: coreIterators)
             delete(coreIterator);
-        srcSource->close();
-        if (pairSource)
-            pairSource->close();
         if (divSource)
             divSource->close();
         delete(srcSource);
         delete(pairSource);
+        delete(srcBuf);
+        delete(pairBuf);
         delete(divSource);
     }
 
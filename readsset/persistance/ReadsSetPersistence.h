@@ -4,6 +4,8 @@
 #include "../DefaultReadsSet.h"
 #include "../PackedConstantLengthReadsSet.h"
 #include "../iterator/ReadsSetIterator.h"
+#include "../iterator/GzipInputStreamBuf.h"
+#include "../iterator/ReadAheadInputStreamBuf.h"
 
 namespace PgSAReadsSet {
 
@@ -15,9 +17,13 @@ namespace PgSAReadsSet {
             vector<ReadsSourceIteratorTemplate< uint_read_len_max>*> coreIterators;
             ReadsSourceIteratorTemplate< uint_read_len_max>* readsIterator = 0;
 
-            ifstream* srcSource = 0;
-            ifstream* pairSource = 0;
+            istream* srcSource = 0;
+            istream* pairSource = 0;
+            std::streambuf* srcBuf = 0;
+            std::streambuf* pairBuf = 0;
             ifstream* divSource = 0;
+
+            static istream* openReadsSource(const string &file, std::streambuf* &sourceBuf);
         public:
             ManagedReadsSetIterator(const string &srcFile, const string &pairFile = "", bool revComplPairFile = false,
                     const string &divisionFile = "", bool divisionComplement = false,
@@ -36,6 +42,12 @@ namespace PgSAReadsSet {
         };
 
     public:
+        // "-" denotes the standard input
+        static const string STDIN_SOURCE;
+
+        // standard input, named pipes and other non-regular files can be read only once (no probing nor rewinding)
+        static bool isStreamSource(const string &file);
+
         static ReadsSourceIteratorTemplate<uint_read_len_max>* createManagedReadsIterator(const string &srcFile,
                                                                                           const string &pairFile = "",
                                                                                           bool revComplPairFile = false,
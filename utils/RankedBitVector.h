@@ -0,0 +1,87 @@
+#ifndef PGTOOLS_RANKEDBITVECTOR_H
+#define PGTOOLS_RANKEDBITVECTOR_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "helper.h"
+
+namespace PgSAHelpers {
+
+    using namespace std;
+
+    // Bit vector with atomic (concurrent) updates and rank support (superblock counts + popcounts)
+    // valid until the next update after buildRank().
+    class RankedBitVector {
+    private:
+        static const size_t WORDS_PER_SUPERBLOCK = 8;
+
+        uint64_t* words = 0;
+        size_t wordsCount = 0;
+        vector<uint64_t> superblockRanks;
+
+        inline size_t bytesCount() const { return wordsCount * sizeof(uint64_t); }
+
+    public:
+        RankedBitVector() {}
+        RankedBitVector(const RankedBitVector &) = delete;
+        RankedBitVector &operator=(const RankedBitVector &) = delete;
+
+        ~RankedBitVector() { clear(); }
+
+        void allocate(size_t bitsCount) {
+            clear();
+            wordsCount = (bitsCount + 63) / 64;
+            words = (uint64_t*) allocateLargeArray(bytesCount());
+        }
+
+        void assign(const RankedBitVector &src) {
+            allocate(src.wordsCount * 64);
+            memcpy(words, src.words, bytesCount());
+        }
+
+        void clear() {
+            freeLargeArray(words, bytesCount());
+            words = 0;
+            wordsCount = 0;
+            vector<uint64_t>().swap(superblockRanks);
+        }
+
+        inline void set(size_t i) { __atomic_fetch_or(words + (i >> 6), 1ULL << (i & 63), __ATOMIC_RELAXED); }
+        inline void reset(size_t i) { __atomic_fetch_and(words + (i >> 6), ~(1ULL << (i & 63)), __ATOMIC_RELAXED); }
+        inline bool operator[](size_t i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+
+        void buildRank() {
+            const size_t superblocksCount = (wordsCount + WORDS_PER_SUPERBLOCK - 1) / WORDS_PER_SUPERBLOCK;
+            superblockRanks.resize(superblocksCount + 1);
+            superblockRanks[0] = 0;
+            #pragma omp parallel for
+            for (size_t s = 0; s < superblocksCount; s++) {
+                const size_t endWord = (s + 1) * WORDS_PER_SUPERBLOCK < wordsCount ? (s + 1) * WORDS_PER_SUPERBLOCK : wordsCount;
+                uint64_t count = 0;
+                for (size_t w = s * WORDS_PER_SUPERBLOCK; w < endWord; w++)
+                    count += __builtin_popcountll(words[w]);
+                superblockRanks[s + 1] = count;
+            }
+            for (size_t s = 0; s < superblocksCount; s++)
+                superblockRanks[s + 1] += superblockRanks[s];
+        }
+
+        // number of set bits before position i
+        inline uint64_t rank(size_t i) const {
+            const size_t word = i >> 6;
+            uint64_t res = superblockRanks[word / WORDS_PER_SUPERBLOCK];
+            for (size_t w = word / WORDS_PER_SUPERBLOCK * WORDS_PER_SUPERBLOCK; w < word; w++)
+                res += __builtin_popcountll(words[w]);
+            if (i & 63)
+                res += __builtin_popcountll(words[word] << (64 - (i & 63)));
+            return res;
+        }
+
+        inline uint64_t count() const { return superblockRanks.empty() ? 0 : superblockRanks.back(); }
+    };
+
+}
+
+#endif //PGTOOLS_RANKEDBITVECTOR_H
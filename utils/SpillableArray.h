@@ -0,0 +1,106 @@
+#ifndef PGTOOLS_SPILLABLEARRAY_H
+#define PGTOOLS_SPILLABLEARRAY_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "helper.h"
+
+namespace PgSAHelpers {
+
+    using namespace std;
+
+    // Zero-initialized array kept in memory or (spilled) in an unlinked temporary file (tempFilesPrefix)
+    // mapped into memory, so that its pages can be written back and evicted under a memory budget.
+    template<typename T>
+    class SpillableArray {
+    private:
+        T* values = 0;
+        size_t count = 0;
+        bool spilled = false;
+
+        void release() {
+            if (values) {
+                if (spilled)
+                    munmap(values, count * sizeof(T));
+                else
+                    freeLargeArray(values, count * sizeof(T));
+            }
+            values = 0;
+            count = 0;
+            spilled = false;
+        }
+
+    public:
+        SpillableArray() {}
+        SpillableArray(const SpillableArray &) = delete;
+        SpillableArray &operator=(const SpillableArray &) = delete;
+
+        ~SpillableArray() { release(); }
+
+        void allocate(size_t n, bool spill) {
+            release();
+            if (n == 0)
+                return;
+            count = n;
+            spilled = spill;
+            if (!spilled) {
+                values = (T*) allocateLargeArray(n * sizeof(T));
+                return;
+            }
+            string fileName = tempFilesPrefix + "spill_XXXXXX";
+            int fd = mkstemp(&fileName[0]);
+            if (fd == -1 || ftruncate(fd, n * sizeof(T)) == -1) {
+                fprintf(stderr, "cannot create temporary file %s\n", fileName.c_str());
+                exit(EXIT_FAILURE);
+            }
+            unlink(fileName.c_str());
+            void* addr = mmap(0, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (addr == MAP_FAILED) {
+                fprintf(stderr, "cannot map temporary file %s\n", fileName.c_str());
+                exit(EXIT_FAILURE);
+            }
+            values = (T*) addr;
+        }
+
+        void clear() { release(); }
+
+        // drops resident pages covering [from, to) elements (spilled contents stay in the file)
+        void evict(size_t from, size_t to) {
+            if (!spilled || from >= to)
+                return;
+            const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+            const uintptr_t begin = (uintptr_t) (values + from) / pageSize * pageSize;
+            const uintptr_t end = (uintptr_t) (values + to);
+            madvise((void*) begin, end - begin, MADV_DONTNEED);
+        }
+
+        inline bool isSpilled() const { return spilled; }
+        inline size_t size() const { return count; }
+
+        inline T* data() { return values; }
+        inline const T* data() const { return values; }
+        inline T* begin() { return values; }
+        inline T* end() { return values + count; }
+        inline const T* begin() const { return values; }
+        inline const T* end() const { return values + count; }
+
+        inline T &operator[](size_t i) { return values[i]; }
+        inline const T &operator[](size_t i) const { return values[i]; }
+
+        void swap(SpillableArray &other) {
+            std::swap(values, other.values);
+            std::swap(count, other.count);
+            std::swap(spilled, other.spilled);
+        }
+    };
+
+}
+
+#endif //PGTOOLS_SPILLABLEARRAY_H
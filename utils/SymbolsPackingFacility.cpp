@@ -2,6 +2,10 @@
 
 #include <cassert>
 
+#ifdef X86_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
 namespace PgSAIndex {
 
     static const vector<char> binaryCodes { 0, 1 };
@@ -64,9 +68,17 @@ namespace PgSAIndex {
         delete[]clearFlat;
         delete[]packLUT0;
         delete[]packLUT1;
+        delete[]realign;
     }
 
     void SymbolsPackingFacility::buildReversePackAndClearIndexes() {
+        keySymbolsCount = 0;
+        symbolsCountPowers[0] = 1;
+        while (symbolsCountPowers[keySymbolsCount] <= UINT64_MAX / symbolsCount) {
+            symbolsCountPowers[keySymbolsCount + 1] = symbolsCountPowers[keySymbolsCount] * symbolsCount;
+            keySymbolsCount++;
+        }
+
         char_pg* rPtr = reverseFlat;
         uint8_t* cPtr = clearFlat;
         for (uint_max i = 0; i <= maxValue; i++) {
@@ -109,6 +121,22 @@ namespace PgSAIndex {
                 packLUT1[temp & PACK_MASK] = (uint8_t) i;
             }
         }
+
+        if (symbolsCount == 5 && symbolsPerElement == 3) {
+            const uint_max n = maxValue + 1;
+            realign = new uint8_t[(symbolsPerElement - 1) * n * n];
+            uint8_t* rePtr = realign;
+            for (uchar reminder = 1; reminder < symbolsPerElement; reminder++)
+                for (uint_max i = 0; i < n; i++)
+                    for (uint_max k = 0; k < n; k++) {
+                        uint8_t value = 0;
+                        for (uchar j = reminder; j < symbolsPerElement; j++)
+                            value = value * symbolsCount + symbolOrder[(uchar) reverse[i][j]];
+                        for (uchar j = 0; j < reminder; j++)
+                            value = value * symbolsCount + symbolOrder[(uchar) reverse[k][j]];
+                        *rePtr++ = value;
+                    }
+        }
     }
 
     uint8_t SymbolsPackingFacility::clearSuffix(const uint8_t value, uchar prefixLength) {
@@ -140,10 +168,110 @@ namespace PgSAIndex {
         return value;
     }
 
+#ifdef X86_SIMD_DISPATCH
+    // Low nibbles of 'A', 'C', 'G', 'N', 'T' (1, 3, 7, E, 4) are distinct, so one in-lane shuffle maps symbols
+    // to their order and another one validates them (unused nibble entries never match a symbol).
+    #define NIBBLE_LUT(n1, n3, n4, n7, nE) \
+        _mm256_setr_epi8(1, n1, 3, n3, n4, 6, 5, n7, 9, 8, 11, 10, 13, 12, nE, 14, \
+                         1, n1, 3, n3, n4, 6, 5, n7, 9, 8, 11, 10, 13, 12, nE, 14)
+
+    // returns -1 if any of 32 symbols is invalid
+    __attribute__((target("avx2")))
+    static inline int symbolsOrderAVX2(const __m256i symbols, const __m256i symbolsLUT, const __m256i orderLUT,
+            __m256i &order) {
+        const __m256i nibbles = _mm256_and_si256(symbols, _mm256_set1_epi8(0x0F));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_shuffle_epi8(symbolsLUT, nibbles), symbols)) != -1)
+            return -1;
+        order = _mm256_shuffle_epi8(orderLUT, nibbles);
+        return 0;
+    }
+
+    // packs 4 symbols per byte (32 symbols per step); returns number of packed symbols
+    __attribute__((target("avx2")))
+    static uint_max packACGTSymbolsAVX2(const char_pg* source, const uint_max length, uint8_t* dest) {
+        const __m256i symbolsLUT = NIBBLE_LUT('A', 'C', 'T', 'G', 15);
+        const __m256i orderLUT = NIBBLE_LUT(0, 1, 3, 2, 0);
+        const __m256i pairWeights = _mm256_set1_epi16(0x0104);
+        const __m256i quadWeights = _mm256_set1_epi32(0x00010010);
+        const __m256i quadLowBytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                      0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m256i lanesJoin = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+        uint_max i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i order;
+            if (symbolsOrderAVX2(_mm256_loadu_si256((const __m256i*) (source + i)), symbolsLUT, orderLUT, order))
+                break;
+            const __m256i quads = _mm256_madd_epi16(_mm256_maddubs_epi16(order, pairWeights), quadWeights);
+            const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(quads, quadLowBytes), lanesJoin);
+            _mm_storel_epi64((__m128i*) (dest + i / 4), _mm256_castsi256_si128(packed));
+        }
+        return i;
+    }
+
+    struct ACGTNDeinterleaveMasks {
+        // mask[t][r] gathers symbols 3j+t (j = 0..15) of a 48 symbols group from its r-th 16 symbols
+        int8_t mask[3][3][32];
+
+        ACGTNDeinterleaveMasks() {
+            for (int t = 0; t < 3; t++)
+                for (int r = 0; r < 3; r++)
+                    for (int j = 0; j < 16; j++)
+                        mask[t][r][j] = mask[t][r][j + 16] = (3 * j + t) / 16 == r ? (3 * j + t) % 16 : -1;
+        }
+    };
+
+    __attribute__((target("avx2")))
+    static inline __m256i multiplyBy5AVX2(const __m256i x) {
+        return _mm256_add_epi8(_mm256_slli_epi16(x, 2), x);
+    }
+
+    // packs 3 symbols per byte (96 symbols per step, 48 per lane); returns number of packed symbols
+    __attribute__((target("avx2")))
+    static uint_max packACGTNSymbolsAVX2(const char_pg* source, const uint_max length, uint8_t* dest) {
+        static const ACGTNDeinterleaveMasks masksBytes;
+        __m256i masks[3][3];
+        for (int t = 0; t < 3; t++)
+            for (int r = 0; r < 3; r++)
+                masks[t][r] = _mm256_loadu_si256((const __m256i*) masksBytes.mask[t][r]);
+        const __m256i symbolsLUT = NIBBLE_LUT('A', 'C', 'T', 'G', 'N');
+        const __m256i orderLUT = NIBBLE_LUT(0, 1, 4, 2, 3);
+        uint_max i = 0;
+        for (; i + 96 <= length; i += 96) {
+            __m256i order[3];
+            int invalid = 0;
+            for (int r = 0; r < 3; r++) {
+                const __m256i symbols = _mm256_inserti128_si256(_mm256_castsi128_si256(
+                        _mm_loadu_si128((const __m128i*) (source + i + 16 * r))),
+                        _mm_loadu_si128((const __m128i*) (source + i + 48 + 16 * r)), 1);
+                invalid |= symbolsOrderAVX2(symbols, symbolsLUT, orderLUT, order[r]);
+            }
+            if (invalid)
+                break;
+            __m256i packed = _mm256_setzero_si256();
+            for (int t = 0; t < 3; t++) {
+                __m256i column = _mm256_setzero_si256();
+                for (int r = 0; r < 3; r++)
+                    column = _mm256_or_si256(column, _mm256_shuffle_epi8(order[r], masks[t][r]));
+                packed = _mm256_add_epi8(multiplyBy5AVX2(packed), column);
+            }
+            _mm256_storeu_si256((__m256i*) (dest + i / 3), packed);
+        }
+        return i;
+    }
+#endif
+
     uint_max SymbolsPackingFacility::packSequence(const char_pg* source, const uint_max length, uint8_t* dest) {
         uint_max i = 0;
 
         const char_pg* guard = source + length - symbolsPerElement;
+#ifdef X86_SIMD_DISPATCH
+        if ((this == &ACGTPacker || this == &ACGTNPacker) && isAVX2Supported()) {
+            const uint_max packedSymbols = this == &ACGTPacker ?
+                    packACGTSymbolsAVX2(source, length, dest) : packACGTNSymbolsAVX2(source, length, dest);
+            i = packedSymbols / symbolsPerElement;
+            source += packedSymbols;
+        }
+#endif
 
         while (source <= guard) {
             dest[i++] = packSymbols(source);
@@ -292,6 +420,12 @@ namespace PgSAIndex {
         return compareSequences(lSeq + 1, rSeq + 1, length);
     }
 
+    static inline uint64_t loadBigEndian64(const uint8_t* ptr) {
+        uint64_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return __builtin_bswap64(value);
+    }
+
     int SymbolsPackingFacility::compareSuffixWithPrefix(uint8_t* sufSeq, uint8_t* preSeq, uint_max sufPos, uint_max length) {
         uint_max i = divideBySmallInteger(sufPos, symbolsPerElement);
         uint_max reminder = moduloBySmallInteger(sufPos, this->symbolsPerElement, i);
@@ -299,7 +433,34 @@ namespace PgSAIndex {
         sufSeq += i;
         if (reminder == 0)
             return compareSequences(sufSeq, preSeq, length);
-        
+
+        if (symbolsCount == 4 && symbolsPerElement == 4) {
+            // 28 symbols of 2-bit codes per step; 8-byte loads stay within both sequences while length >= 32
+            const uchar shift = 2 * reminder;
+            while (length >= 32) {
+                const uint64_t sufWord = loadBigEndian64(sufSeq) << shift;
+                const uint64_t preWord = loadBigEndian64(preSeq);
+                const uint64_t diff = (sufWord ^ preWord) & 0xFFFFFFFFFFFFFF00ULL;
+                if (diff) {
+                    const uchar bitShift = 62 - (__builtin_clzll(diff) & ~1);
+                    return (int) symbolsList[(sufWord >> bitShift) & 3] - symbolsList[(preWord >> bitShift) & 3];
+                }
+                sufSeq += 7;
+                preSeq += 7;
+                length -= 28;
+            }
+        } else if (realign) {
+            const uint_max n = maxValue + 1;
+            const uint8_t* reminderRealign = realign + (reminder - 1) * n * n;
+            while (length >= symbolsPerElement && reminderRealign[sufSeq[0] * n + sufSeq[1]] == *preSeq) {
+                sufSeq++;
+                preSeq++;
+                length -= symbolsPerElement;
+            }
+            if (length == 0)
+                return 0;
+        }
+
         uchar sufIdx = reminder;
         uchar preIdx = 0;
         while (true) {
@@ -317,6 +478,37 @@ namespace PgSAIndex {
         }
     }
 
+    uint64_t SymbolsPackingFacility::getSequenceKey(const uint8_t* sequence, uint_max pos, uint_max length) {
+        if (length > keySymbolsCount)
+            length = keySymbolsCount;
+        if (length == 0)
+            return 0;
+        uint_max i = divideBySmallInteger(pos, symbolsPerElement);
+        uchar reminder = moduloBySmallInteger(pos, this->symbolsPerElement, i);
+
+        uint64_t key = 0;
+        uint_max keyLength = 0;
+        if (reminder) {
+            uint_max count = symbolsPerElement - reminder;
+            key = sequence[i++] % symbolsCountPowers[count];
+            if (count > length) {
+                key /= symbolsCountPowers[count - length];
+                count = length;
+            }
+            keyLength = count;
+        }
+        while (keyLength + symbolsPerElement <= length) {
+            key = key * symbolsCountPowers[symbolsPerElement] + sequence[i++];
+            keyLength += symbolsPerElement;
+        }
+        if (keyLength < length) {
+            const uint_max count = length - keyLength;
+            key = key * symbolsCountPowers[count] + sequence[i] / symbolsCountPowers[symbolsPerElement - count];
+            keyLength = length;
+        }
+        return key * symbolsCountPowers[keySymbolsCount - keyLength];
+    }
+
     int SymbolsPackingFacility::compareSequenceWithUnpacked(uint_ps_element_min *seq,
                                                                           const char *pattern,
                                                                           uint_read_len_max length) {
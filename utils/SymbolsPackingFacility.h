@@ -35,6 +35,14 @@ namespace PgSAIndex {
             uint8_t** clear;
             uint8_t* clearFlat;
 
+            // for base-5 packing (3 symbols per element) realign[(reminder - 1) * n * n + value * n + nextValue],
+            // where n = maxValue + 1, returns the element of 3 symbols starting at reminder position of value
+            uint8_t* realign = 0;
+
+            // powers of symbolsCount up to keySymbolsCount (maximal number of symbols encoded in uint64_t key)
+            uint64_t symbolsCountPowers[64];
+            uchar keySymbolsCount;
+
             const bool globallyManaged = false;
 
             void buildReversePackAndClearIndexes();
@@ -84,6 +92,11 @@ namespace PgSAIndex {
             int compareSequences(uint8_t* lSeq, uint8_t* rSeq, uint_max pos, uint_max length);
             int compareSuffixWithPrefix(uint8_t* sufSeq, uint8_t* preSeq, uint_max sufPos, uint_max length);
 
+            // first (up to keySymbolsCount) symbols from pos as base-symbolsCount number padded to keySymbolsCount symbols
+            // (keys order is consistent with compareSequences)
+            uint64_t getSequenceKey(const uint8_t* sequence, uint_max pos, uint_max length);
+            inline uchar getKeySymbolsCount() { return keySymbolsCount; }
+
             int compareSequenceWithUnpacked(uint_ps_element_min *seq, const char *pattern, uint_read_len_max length);
 
             uint8_t countSequenceMismatchesVsUnpacked(uint_ps_element_min *seq, const char *pattern, uint_read_len_max length,
@@ -0,0 +1,91 @@
+// Randomized equivalence check of SymbolsPackingFacility::compareSuffixWithPrefix
+// against its previous per-symbol implementation.
+
+#include "SymbolsPackingFacility.h"
+
+#include <random>
+
+using namespace PgSAIndex;
+
+static const uint_max MAX_SEQUENCE_LENGTH = 300;
+static const uint32_t ITERATIONS_PER_PACKING = 200000;
+
+static inline int sign(int value) { return (value > 0) - (value < 0); }
+
+// compareSuffixWithPrefix before the word-wise comparison (decodes one symbol at a time)
+static int compareSuffixWithPrefixReference(SymbolsPackingFacility &packer, uint_max symbolsPerElement,
+        uint8_t* sufSeq, uint8_t* preSeq, uint_max sufPos, uint_max length) {
+    uint_max reminder = sufPos % symbolsPerElement;
+
+    sufSeq += sufPos / symbolsPerElement;
+    if (reminder == 0)
+        return packer.compareSequences(sufSeq, preSeq, length);
+
+    uchar sufIdx = reminder;
+    uchar preIdx = 0;
+    while (true) {
+        int cmp = (int) packer.reverseValue(*sufSeq, sufIdx) - packer.reverseValue(*preSeq, preIdx);
+        if (cmp)
+            return cmp;
+        if (--length == 0)
+            return 0;
+        if (++preIdx == symbolsPerElement) {
+            preIdx = 0; preSeq++;
+        }
+        if (++sufIdx == symbolsPerElement) {
+            sufIdx = 0; sufSeq++;
+        }
+    }
+}
+
+static bool checkPacking(const vector<char> &symbols, std::mt19937_64 &rng) {
+    SymbolsPackingFacility packer(symbols);
+    const uint_max symbolsPerElement = SymbolsPackingFacility::maxSymbolsPerElement(symbols.size());
+    uint32_t failures = 0;
+    for (uint32_t it = 0; it < ITERATIONS_PER_PACKING; it++) {
+        const uint_max sufLength = 1 + rng() % MAX_SEQUENCE_LENGTH;
+        string sufSeq(sufLength, 0);
+        for (char &c: sufSeq)
+            c = symbols[rng() % symbols.size()];
+        const uint_max sufPos = rng() % sufLength;
+        const uint_max maxLength = sufLength - sufPos;
+        // mostly an overlap (a copy of the suffix) with a single mismatch somewhere or none
+        string preSeq(sufSeq.substr(sufPos));
+        preSeq.resize(maxLength + rng() % (MAX_SEQUENCE_LENGTH / 2));
+        for (uint_max i = maxLength; i < preSeq.size(); i++)
+            preSeq[i] = symbols[rng() % symbols.size()];
+        if (rng() % 4 == 0)
+            for (char &c: preSeq)
+                c = symbols[rng() % symbols.size()];
+        else if (rng() % 4)
+            preSeq[rng() % maxLength] = symbols[rng() % symbols.size()];
+        const uint_max length = rng() % 2 ? maxLength : rng() % (maxLength + 1);
+
+        vector<uint8_t> packedSuf((sufLength + symbolsPerElement - 1) / symbolsPerElement);
+        vector<uint8_t> packedPre((preSeq.size() + symbolsPerElement - 1) / symbolsPerElement);
+        packer.packSequence(sufSeq.data(), sufLength, packedSuf.data());
+        packer.packSequence(preSeq.data(), preSeq.size(), packedPre.data());
+
+        // only the sign of the result is significant
+        const int expected = sign(length ? compareSuffixWithPrefixReference(packer, symbolsPerElement,
+                packedSuf.data(), packedPre.data(), sufPos, length) : 0);
+        const int actual = sign(length ? packer.compareSuffixWithPrefix(packedSuf.data(), packedPre.data(), sufPos, length) : 0);
+        if (actual != expected && failures++ < 10)
+            fprintf(stderr, "%zu symbols packing mismatch: suffix %s from %llu, prefix %s, length %llu: %d instead of %d\n",
+                    symbols.size(), sufSeq.c_str(), (unsigned long long) sufPos, preSeq.c_str(),
+                    (unsigned long long) length, actual, expected);
+    }
+    fprintf(stdout, "%zu symbols (%llu per element): %u of %u comparisons failed.\n", symbols.size(),
+            (unsigned long long) symbolsPerElement, failures, ITERATIONS_PER_PACKING);
+    return failures == 0;
+}
+
+int main(int argc, char *argv[]) {
+    std::mt19937_64 rng(argc > 1 ? atoll(argv[1]) : 17);
+    bool passed = true;
+    passed &= checkPacking({ 'A', 'C', 'G', 'T' }, rng);
+    passed &= checkPacking({ 'A', 'C', 'G', 'N', 'T' }, rng);
+    // generic per-symbol path (packing LUTs support up to 4 symbols per element)
+    passed &= checkPacking({ 'A', 'C', 'G', 'N', 'T', 'U' }, rng);
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
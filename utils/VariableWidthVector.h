@@ -0,0 +1,102 @@
+#ifndef PGTOOLS_VARIABLEWIDTHVECTOR_H
+#define PGTOOLS_VARIABLEWIDTHVECTOR_H
+
+#include <vector>
+#include <limits>
+#include <stdint.h>
+
+namespace PgSAHelpers {
+
+    using namespace std;
+
+    // Unsigned values stored as uint_narrow until a value exceeds its range, then as uint_wide.
+    template<typename uint_narrow, typename uint_wide>
+    class VariableWidthVector {
+    protected:
+        vector<uint_narrow> narrowValues;
+        vector<uint_wide> wideValues;
+        bool wideMode = false;
+
+        static inline bool isNarrowValue(uint_wide value) { return value <= numeric_limits<uint_narrow>::max(); }
+
+    public:
+        VariableWidthVector() {}
+
+        VariableWidthVector(vector<uint_narrow> &&values): narrowValues(std::move(values)) {}
+
+        void useWideValues() {
+            if (wideMode)
+                return;
+            wideValues.assign(narrowValues.begin(), narrowValues.end());
+            vector<uint_narrow>().swap(narrowValues);
+            wideMode = true;
+        }
+
+        inline bool isNarrow() const { return !wideMode; }
+        // true if set(i, value) stores value without switching to wide values (i.e. without reallocation)
+        inline bool holdsWithoutWidening(uint_wide value) const { return wideMode || isNarrowValue(value); }
+        inline uint8_t bytesPerValue() const { return wideMode ? sizeof(uint_wide) : sizeof(uint_narrow); }
+
+        inline size_t size() const { return wideMode ? wideValues.size() : narrowValues.size(); }
+        inline bool empty() const { return size() == 0; }
+
+        inline uint_wide operator[](size_t i) const { return wideMode ? wideValues[i] : narrowValues[i]; }
+        inline uint_wide back() const { return wideMode ? wideValues.back() : narrowValues.back(); }
+
+        inline void set(size_t i, uint_wide value) {
+            if (!wideMode && !isNarrowValue(value))
+                useWideValues();
+            if (wideMode)
+                wideValues[i] = value;
+            else
+                narrowValues[i] = value;
+        }
+
+        inline void push_back(uint_wide value) {
+            if (!wideMode && !isNarrowValue(value))
+                useWideValues();
+            if (wideMode)
+                wideValues.push_back(value);
+            else
+                narrowValues.push_back(value);
+        }
+
+        void append(const VariableWidthVector &src) {
+            if (src.wideMode)
+                useWideValues();
+            if (wideMode) {
+                if (src.wideMode)
+                    wideValues.insert(wideValues.end(), src.wideValues.begin(), src.wideValues.end());
+                else
+                    wideValues.insert(wideValues.end(), src.narrowValues.begin(), src.narrowValues.end());
+            } else
+                narrowValues.insert(narrowValues.end(), src.narrowValues.begin(), src.narrowValues.end());
+        }
+
+        void reserve(size_t n) { wideMode ? wideValues.reserve(n) : narrowValues.reserve(n); }
+        void resize(size_t n, uint_wide value = 0) {
+            if (!wideMode && !isNarrowValue(value))
+                useWideValues();
+            wideMode ? wideValues.resize(n, value) : narrowValues.resize(n, value);
+        }
+        void clear() { narrowValues.clear(); wideValues.clear(); }
+        void shrink_to_fit() { wideMode ? wideValues.shrink_to_fit() : narrowValues.shrink_to_fit(); }
+        void swap(VariableWidthVector &other) {
+            narrowValues.swap(other.narrowValues);
+            wideValues.swap(other.wideValues);
+            std::swap(wideMode, other.wideMode);
+        }
+
+        inline char* data() { return wideMode ? (char*) wideValues.data() : (char*) narrowValues.data(); }
+        inline const char* data() const { return wideMode ? (char*) wideValues.data() : (char*) narrowValues.data(); }
+        inline size_t dataSize() const { return size() * bytesPerValue(); }
+
+        vector<uint_narrow> &getNarrowVector() { return narrowValues; }
+        vector<uint_wide> &getWideVector() { return wideValues; }
+        const vector<uint_narrow> &getNarrowVector() const { return narrowValues; }
+        const vector<uint_wide> &getWideVector() const { return wideValues; }
+    };
+
+}
+
+#endif //PGTOOLS_VARIABLEWIDTHVECTOR_H
@@ -1,11 +1,53 @@
 #include "helper.h"
 
 #include "byteswap.h"
+#include <sys/mman.h>
 
 std::ostream *PgSAHelpers::logout = &std::cout;
 
 int PgSAHelpers::numberOfThreads = 8;
 
+uint64_t PgSAHelpers::maxMemoryUsage = 0;
+string PgSAHelpers::tempFilesPrefix = "";
+
+bool PgSAHelpers::isAVX2Supported() {
+#ifdef X86_SIMD_DISPATCH
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool PgSAHelpers::isAVX512BWSupported() {
+#ifdef X86_SIMD_DISPATCH
+    static const bool supported = __builtin_cpu_supports("avx512bw");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void* PgSAHelpers::allocateLargeArray(size_t bytes) {
+    if (bytes == 0)
+        return 0;
+    void* addr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        fprintf(stderr, "cannot allocate %zu bytes\n", bytes);
+        exit(EXIT_FAILURE);
+    }
+#ifdef MADV_HUGEPAGE
+    if (bytes >= LARGE_ARRAY_HUGEPAGE_MIN_BYTES)
+        madvise(addr, bytes, MADV_HUGEPAGE);
+#endif
+    return addr;
+}
+
+void PgSAHelpers::freeLargeArray(void* ptr, size_t bytes) {
+    if (ptr)
+        munmap(ptr, bytes);
+}
+
 NullBuffer null_buffer;
 std::ostream null_stream(&null_buffer);
 
@@ -16,6 +16,12 @@
 
 using namespace std;
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define X86_SIMD_DISPATCH
+#endif
+
+#define LARGE_ARRAY_HUGEPAGE_MIN_BYTES (1 << 21)
+
 class NullBuffer : public std::streambuf
 {
 public:
@@ -28,6 +34,19 @@ namespace PgSAHelpers {
 
     extern int numberOfThreads;
 
+    // memory budget in bytes (0 - unlimited) and path prefix of temporary files of out-of-core processing
+    extern uint64_t maxMemoryUsage;
+    extern string tempFilesPrefix;
+
+    // runtime CPU check guarding code compiled with __attribute__((target("avx2")))
+    bool isAVX2Supported();
+    // runtime CPU check guarding code compiled with __attribute__((target("avx512bw")))
+    bool isAVX512BWSupported();
+
+    // zero-initialized anonymous mapping (advised to be backed by transparent huge pages when large)
+    void* allocateLargeArray(size_t bytes);
+    void freeLargeArray(void* ptr, size_t bytes);
+
     // bioinformatical routines
 
     char reverseComplement(char symbol);